@@ -1,9 +1,22 @@
 #include "math.h"
 #include "geometry.h"
+#ifdef MATH_EXPRESSION_TEMPLATES
+#include "vector_expression.h"
+#endif
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <bit>
 #include <SDL2/SDL.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <fstream>
+#include <map>
+#include <functional>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
 
 
 
@@ -16,23 +29,35 @@
 // Ein "Bildschirm", der das Setzen eines Pixels kapselt
 // Der Bildschirm hat eine Auflösung (Breite x Höhe)
 // Kann zur Ausgabe einer PPM-Datei verwendet werden oder
+// mit SDL2 implementiert werden.
+// Ohne Fenster (headless) werden keine SDL-Funktionen aufgerufen, das Bild kann dann nur
+// als PPM- (8 Bit) oder PFM-Datei (float) gespeichert werden.
 class Screen 
 {
 
 size_t full_width, full_height;
-std::vector<Vector3df> pixels;
+bool headless;
+std::vector<Vector3df> pixels;   // Farben als float, können für HDR auch größer als 1 sein
+std::vector<Uint8> rgba;         // gepackte 8-Bit-Farben (R,G,B,A je Pixel) für die Textur
 
 SDL_Window* window = nullptr;
 SDL_Renderer* renderer = nullptr;
+SDL_Texture* texture = nullptr;
 
 public:
 
-  Screen (size_t width, size_t height) : full_width(width), full_height(height) 
+  Screen (size_t width, size_t height, bool headless = false) : full_width(width), full_height(height), headless(headless)
   {
       pixels.resize(full_width*full_height, Vector3df{0.0, 0.0, 0.0});
+      rgba.resize(4 * full_width * full_height, 255);
+      if (headless) {
+        return;
+      }
       
       SDL_Init(SDL_INIT_VIDEO);
       SDL_CreateWindowAndRenderer(width, height, 0, &window, &renderer);
+      // Streaming-Textur: wird bei jedem update() mit einem einzigen Aufruf neu befüllt
+      texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, width, height);
   }
 
   // x und y sind Bildkoordinaten 
@@ -43,43 +68,107 @@ public:
 
   ~Screen()
   {
+    if (texture) SDL_DestroyTexture(texture);
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
-    SDL_Quit();
+    if (!headless) SDL_Quit();
   }
 
-  void show()
-  {
-    SDL_SetRenderDrawColor(renderer, 0,0,0,255); //schwarz
-    SDL_RenderClear(renderer);
+  size_t get_width() const { return full_width; }
+  size_t get_height() const { return full_height; }
 
-    for (size_t y = 0; y < full_height; ++y) {
-      for (size_t x = 0; x < full_width; ++x) {
-        Vector3df c = pixels[y * full_width + x];
-
-              int r = (int)(c[0] * 255);
-              int g = (int)(c[1] * 255);
-              int b = (int)(c[2] * 255);
-
-              //falls Licht zu hell
-              if (r > 255) r = 255;
-              if (g > 255) g = 255;
-              if (b > 255) b = 255;
-              
-              SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-              SDL_RenderDrawPoint(renderer, x, y);
+  // wandelt alle float-Farben in einem Durchlauf in 8-Bit-Farben um
+  // Farbanteile werden auf [0, 1] begrenzt (falls Licht zu hell), mit 255 multipliziert und der Nachkommaanteil verworfen.
+  // Die Schleife hat keine Verzweigungen, damit der Compiler sie vektorisieren kann.
+  void convert_to_rgba()
+  {
+    const size_t count = full_width * full_height;
+    const Vector3df * source = pixels.data();
+    Uint8 * target = rgba.data();
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t channel = 0; channel < 3; ++channel) {
+        float value = std::min(std::max(source[i][channel], 0.0f), 1.0f);
+        target[4 * i + channel] = (Uint8)(value * 255.0f);
       }
     }
+  }
+
+  // zeichnet den aktuellen Inhalt von pixels ins Fenster und arbeitet anstehende Events ab,
+  // ohne zu blockieren. Gibt false zurück, wenn das Fenster geschlossen wurde.
+  bool update()
+  {
+    if (headless) {
+      return true;
+    }
+    convert_to_rgba();
+    SDL_UpdateTexture(texture, nullptr, rgba.data(), (int)(4 * full_width));
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
     SDL_RenderPresent(renderer);
 
     SDL_Event e;
     bool running = true;
+    while (SDL_PollEvent(&e)) {
+        if (e.type == SDL_QUIT) running = false;
+    }
+    return running;
+  }
+
+  // zeigt das Bild an und wartet, bis das Fenster geschlossen wird
+  void show()
+  {
+    if (headless) {
+      return;
+    }
+    bool running = update();
+    SDL_Event e;
     while (running) {
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) running = false;
         }
     }
   }
+
+  // speichert das Bild als binäre PPM-Datei (P6) mit 8 Bit je Farbanteil
+  // gibt false zurück, wenn die Datei nicht geschrieben werden konnte
+  bool write_ppm(const std::string & filename)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+      return false;
+    }
+    convert_to_rgba();
+    out << "P6\n" << full_width << " " << full_height << "\n255\n";
+    std::vector<Uint8> rgb(3 * full_width * full_height);
+    for (size_t i = 0; i < full_width * full_height; ++i) {
+      std::memcpy(&rgb[3 * i], &rgba[4 * i], 3);
+    }
+    out.write(reinterpret_cast<const char *>(rgb.data()), rgb.size());
+    return out.good();
+  }
+
+  // speichert die ungerundeten float-Farben als PFM-Datei (HDR) in der Byte-Reihenfolge des Rechners
+  // PFM speichert die Zeilen von unten nach oben, das Vorzeichen des Skalierungsfaktors gibt die
+  // Byte-Reihenfolge an: negativ für Little Endian, positiv für Big Endian
+  bool write_pfm(const std::string & filename)
+  {
+    static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+                  "PFM kennt nur Little und Big Endian");
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+      return false;
+    }
+    const char * scale = std::endian::native == std::endian::little ? "-1.0" : "1.0";
+    out << "PF\n" << full_width << " " << full_height << "\n" << scale << "\n";
+    for (size_t y = full_height; y-- > 0; ) {
+      for (size_t x = 0; x < full_width; ++x) {
+        const Vector3df & c = pixels[y * full_width + x];
+        out.write(reinterpret_cast<const char *>(c.vector.data()), 3 * sizeof(float));
+      }
+    }
+    return out.good();
+  }
+
 };
 
 
@@ -123,8 +212,14 @@ Camera(Vector3df eye_pos, Vector3df look_at, Vector3df up_direction, size_t widt
 
 Ray3df get_ray(size_t x, size_t y)
 {
-  float offset_x = ((float)x - (float)image_width / 2.0f) * pixel_size;
-  float offset_y = ((float)image_height / 2.0f - (float)y) * pixel_size;
+  return get_ray((float)x, (float)y);
+}
+
+// Sehstrahl für eine Position innerhalb eines Pixels, z.B. x + 0.25f für Supersampling
+Ray3df get_ray(float x, float y)
+{
+  float offset_x = (x - (float)image_width / 2.0f) * pixel_size;
+  float offset_y = ((float)image_height / 2.0f - y) * pixel_size;
 
   Vector3df ray_direction = direction + (offset_x * right) + (offset_y * up);
   ray_direction.normalize();
@@ -154,14 +249,56 @@ public:
   Vector3df ambient;      // Umgebungsfarbe
   Vector3df diffuse;      // Matte Farbe (Hauptfarbe)
   Vector3df mirrorcolour; // Spiegelfarbe
+  bool reflective;        // true, wenn mirrorcolour nicht schwarz ist (einmalig im Konstruktor bestimmt)
   
   // Konstruktor
   Material(Vector3df amb, Vector3df diff, Vector3df spec)
-    : ambient(amb), diffuse(diff), mirrorcolour(spec)
+    : ambient(amb), diffuse(diff), mirrorcolour(spec),
+      reflective(spec[0] > 0 || spec[1] > 0 || spec[2] > 0)
   {
   }
 };
 
+// komponentenweises Produkt zweier Farben, z.B. Materialfarbe * Lichtfarbe
+Vector3df multiply(const Vector3df & a, const Vector3df & b)
+{
+  return Vector3df{ a[0] * b[0], a[1] * b[1], a[2] * b[2] };
+}
+
+// zusammengesetzte Operationen des Shade-Pfads
+// mit MATH_EXPRESSION_TEMPLATES werden sie ohne temporaere Vektoren in einer Schleife berechnet
+//   (siehe vector_expression.h), die Ergebnisse sind bitgenau gleich
+
+// p + t * d, z.B. Punkt auf einem Strahl
+Vector3df add_scaled(const Vector3df & p, float t, const Vector3df & d)
+{
+#ifdef MATH_EXPRESSION_TEMPLATES
+  return expr::evaluate(expr::lazy(p) + t * expr::lazy(d));
+#else
+  return p + (t * d);
+#endif
+}
+
+// sum += a * b (komponentenweise)
+void add_product(Vector3df & sum, const Vector3df & a, const Vector3df & b)
+{
+#ifdef MATH_EXPRESSION_TEMPLATES
+  expr::add_to(sum, expr::multiply(expr::lazy(a), expr::lazy(b)));
+#else
+  sum += multiply(a, b);
+#endif
+}
+
+// sum += factor * (a * b) (komponentenweise)
+void add_scaled_product(Vector3df & sum, float factor, const Vector3df & a, const Vector3df & b)
+{
+#ifdef MATH_EXPRESSION_TEMPLATES
+  expr::add_to(sum, factor * expr::multiply(expr::lazy(a), expr::lazy(b)));
+#else
+  sum += factor * multiply(a, b);
+#endif
+}
+
 // verschiedene Materialdefinition, z.B. Mattes Schwarz, Mattes Rot, Reflektierendes Weiss, ...
 // im wesentlichen Variablen, die mit Konstruktoraufrufen initialisiert werden.
 
@@ -217,28 +354,46 @@ Material mat_yellow(
 // Ein "Objekt", z.B. eine Kugel oder ein Dreieck, und dem zugehörigen Material der Oberfläche.
 // Im Prinzip ein Wrapper-Objekt, das mindestens Material und geometrisches Objekt zusammenfasst.
 // Kugel und Dreieck finden Sie in geometry.h/tcc
+// Das Material wird nicht kopiert, sondern über seinen Index in der Materialtabelle der Szene referenziert.
 
 class Object
 {
   Sphere3df sphere;
-  Material material;
   Vector3df center; 
+  size_t material;
 
 public:
-  Object(Vector3df c, float r, Material m) 
-    : sphere(Sphere3df{c, r}), material(m), center(c) {}
+  Object(Vector3df c, float r, size_t material_index) 
+    : sphere(Sphere3df{c, r}), center(c), material(material_index) {}
+
+  // gibt den Abstand zum Schnittpunkt zurück oder einen Wert <= 0, falls es keinen gibt
+  float intersect(const Ray3df & ray) const {
+    return sphere.intersects(ray);
+  }
 
-  float intersect(Ray3df ray){
-    float distance = sphere.intersects(ray);
-    if(distance > 0){ return distance;}
-    return -1;
+  // Normale im Punkt hit_point auf der Oberfläche
+  Vector3df normal(const Vector3df & hit_point) const {
+    Vector3df n = hit_point - center;
+    n.normalize();
+    return n;
   }
 
-  Material& get_material(){ return material;}
+  size_t get_material() const { return material; }
+
+  const Sphere3df& get_sphere() const { return sphere;}
+
+  const Vector3df& get_center() const { return center;}
+};
 
-   Sphere3df& get_sphere(){ return sphere;}
 
-   Vector3df& get_center(){ return center;}
+// Ein Schnittpunkt eines Sehstrahls mit dem nächstgelegenen Objekt.
+// Schnittpunkt und Normale werden genau einmal berechnet, wenn das nächste Objekt feststeht.
+struct Hit
+{
+  float t = 0.0f;          // hit_point = ray.origin + t * ray.direction
+  uint32_t object = 0;     // Index des Objekts in der Szene
+  Vector3df point{0.0, 0.0, 0.0};
+  Vector3df normal{0.0, 0.0, 0.0};
 };
 
 
@@ -250,19 +405,29 @@ public:
 class Scene
 {
   std::vector<Object> objects;
+  std::vector<Material> materials;
   std::vector<Light> lights;
 
   public:
 
+  // fügt ein Material zur Materialtabelle hinzu und gibt seinen Index zurück
+  size_t add_material(const Material & material){
+      materials.push_back(material);
+      return materials.size() - 1;
+  }
+
   void add_object(Object obj){objects.push_back(obj);}
 
   void add_light(Vector3df pos, Vector3df col){
       lights.push_back(Light{pos, col});
   }
 
-  Object* find_nearest(Ray3df ray, float& distanz_out);
-  Vector3df shade(Ray3df ray, Object* obj, float distance);
-  Vector3df trace(Ray3df ray, int depth);
+  const Material & get_material(const Object & obj) const { return materials[obj.get_material()]; }
+
+  bool find_nearest(const Ray3df & ray, Hit & hit) const;
+  bool occluded(const Ray3df & ray, float max_distance) const;
+  Vector3df shade(const Ray3df & ray, const Hit & hit) const;
+  Vector3df trace(const Ray3df & ray, int depth) const;
 };
 
 
@@ -275,17 +440,24 @@ Scene create_cornell_box()
   Scene scene;
   float wall_r = 1e5f;
 
+  size_t red = scene.add_material(mat_red);
+  size_t green = scene.add_material(mat_green);
+  size_t yellow = scene.add_material(mat_yellow);
+  size_t blue = scene.add_material(mat_blue);
+  size_t white = scene.add_material(mat_white);
+  size_t mirror = scene.add_material(mat_mirror);
+
   // Wände
-  scene.add_object(Object(Vector3df{-wall_r - 2.0f, 0.0f, -5.0f}, wall_r, mat_red));   // Links
-  scene.add_object(Object(Vector3df{ wall_r + 2.0f, 0.0f, -5.0f}, wall_r, mat_green)); // Rechts
-  scene.add_object(Object(Vector3df{0.0f, 0.0f, -wall_r - 10.0f}, wall_r, mat_yellow));  // Hinten
-  scene.add_object(Object(Vector3df{0.0f, -wall_r - 2.0f, -5.0f}, wall_r, mat_blue)); // Boden
-  scene.add_object(Object(Vector3df{0.0f,  wall_r + 2.0f, -5.0f}, wall_r, mat_white)); // Decke
+  scene.add_object(Object(Vector3df{-wall_r - 2.0f, 0.0f, -5.0f}, wall_r, red));   // Links
+  scene.add_object(Object(Vector3df{ wall_r + 2.0f, 0.0f, -5.0f}, wall_r, green)); // Rechts
+  scene.add_object(Object(Vector3df{0.0f, 0.0f, -wall_r - 10.0f}, wall_r, yellow));  // Hinten
+  scene.add_object(Object(Vector3df{0.0f, -wall_r - 2.0f, -5.0f}, wall_r, blue)); // Boden
+  scene.add_object(Object(Vector3df{0.0f,  wall_r + 2.0f, -5.0f}, wall_r, white)); // Decke
   
   // Kugeln
-  scene.add_object(Object(Vector3df{-1.0f, -1.0f, -6.0f}, 1.0f, mat_mirror));
-  scene.add_object(Object(Vector3df{ 0.8f, -1.2f, -4.5f}, 0.8f, mat_yellow));
-  scene.add_object(Object(Vector3df{ 0.0f, 0.5f, -5.0f}, 0.5f, mat_red));
+  scene.add_object(Object(Vector3df{-1.0f, -1.0f, -6.0f}, 1.0f, mirror));
+  scene.add_object(Object(Vector3df{ 0.8f, -1.2f, -4.5f}, 0.8f, yellow));
+  scene.add_object(Object(Vector3df{ 0.0f, 0.5f, -5.0f}, 0.5f, red));
   
   // Lichter  
   scene.add_light(Vector3df{0.0f, 1.8f, -5.0f}, Vector3df{0.8f, 0.8f, 0.8f});
@@ -301,130 +473,580 @@ Scene create_cornell_box()
 // Szene-Objekts ist, dann kann auf die Werte teilweise direkt zugegriffen werden.
 // Bei mehreren Lichtquellen muss der resultierende diffuse Farbanteil durch die Anzahl Lichtquellen geteilt werden.
 
-Vector3df Scene::shade(Ray3df ray, Object* obj, float distance) {
-
-    // Schnittpunkt berechnen
-    Vector3df hit_point = ray.origin + (distance * ray.direction);
+Vector3df Scene::shade(const Ray3df &, const Hit & hit) const {
 
-    // Normale berechnen
-    Vector3df normal = hit_point - obj->get_center();
-    normal.normalize();
+    const Material & material = materials[objects[hit.object].get_material()];
 
     Vector3df diffuse_sum = {0,0,0};
 
-    for ( auto& light : lights) {
+    // Schatten 
+    Vector3df shadow_origin = add_scaled(hit.point, 0.1f, hit.normal);
+
+    for (const auto& light : lights) {
         
-        Vector3df light_vec = light.position - hit_point;
+        Vector3df light_vec = light.position - hit.point;
         float dist_to_light = sqrt(light_vec * light_vec);
 
         Vector3df light_dir = light_vec;
         light_dir.normalize(); 
 
-        // Schatten 
-        Vector3df shadow_origin = hit_point + (0.1f * normal);
-        Ray3df shadow_ray = { shadow_origin, light_dir };
-
-        float shadow_dist;
-        Object* shadow_obj = find_nearest(shadow_ray, shadow_dist);
-
-        bool in_shadow = false;
-        if (shadow_obj != nullptr) {
-            if (shadow_dist < dist_to_light) {
-                in_shadow = true;
-            }
-        }
+        float intensity = hit.normal * light_dir;
 
-        // Nur beleuchten, wenn NICHT im Schatten
-        if (!in_shadow) {
-            float intensity = normal * light_dir;
-            
-            if (intensity > 0) {
-                Vector3df combined_color = {
-                    obj->get_material().diffuse[0] * light.color[0],
-                    obj->get_material().diffuse[1] * light.color[1],
-                    obj->get_material().diffuse[2] * light.color[2]
-                };
-                
-                diffuse_sum = diffuse_sum + (intensity * combined_color);
-            }
+        // Nur beleuchten, wenn die Fläche zum Licht zeigt und NICHT im Schatten liegt
+        if (intensity > 0 && !occluded(Ray3df{ shadow_origin, light_dir }, dist_to_light)) {
+            add_scaled_product(diffuse_sum, intensity, material.diffuse, light.color);
         }
     }
 
-    return obj->get_material().ambient + diffuse_sum;
+    return material.ambient + diffuse_sum;
 }
 
 
 // Für einen Sehstrahl aus allen Objekte, dasjenige finden, das dem Augenpunkt am nächsten liegt.
-// Am besten einen Zeiger auf das Objekt zurückgeben. Wenn dieser nullptr ist, dann gibt es kein sichtbares Objekt.
+// Gibt false zurück, wenn es kein sichtbares Objekt gibt. Sonst ist hit vollständig gesetzt.
 
-Object* Scene::find_nearest(Ray3df ray, float& distanz_out)
+bool Scene::find_nearest(const Ray3df & ray, Hit & hit) const
 {
-  Object* nearest_Object = nullptr;
   float current_min_dist = 9e9; 
+  uint32_t nearest_object = 0;
+  bool found = false;
   
-  for (auto& obj : objects)
+  for (uint32_t i = 0; i < objects.size(); ++i)
   {
-    float distance = obj.intersect(ray);
+    float distance = objects[i].intersect(ray);
     if (distance > 0.0f && distance < current_min_dist) {
       current_min_dist = distance;
-      nearest_Object = &obj;
+      nearest_object = i;
+      found = true;
     }
   }
-  distanz_out = current_min_dist;
-  return nearest_Object;
+  if (found) {
+    hit.t = current_min_dist;
+    hit.object = nearest_object;
+    hit.point = add_scaled(ray.origin, current_min_dist, ray.direction);
+    hit.normal = objects[nearest_object].normal(hit.point);
+  }
+  return found;
 }
 
+// true, wenn irgendein Objekt den Strahl vor max_distance schneidet (Schattentest)
+// bricht beim ersten gefundenen Objekt ab, das nächste Objekt muss nicht bestimmt werden
 
-// Die rekursive raytracing-Methode. Am besten ab einer bestimmten Rekursionstiefe (z.B. als Parameter übergeben) abbrechen.
-// (Aktuell noch nicht rekursiv implementiert, das kommt später für Reflexionen)
-
-Vector3df Scene::trace(Ray3df ray, int depth) {
-    if (depth <= 0) {
-        return Vector3df{0, 0, 0};
+bool Scene::occluded(const Ray3df & ray, float max_distance) const
+{
+  for (const Object & obj : objects) {
+    float distance = obj.intersect(ray);
+    if (distance > 0.0f && distance < max_distance) {
+      return true;
     }
+  }
+  return false;
+}
+
+
+// Die raytracing-Methode. Bricht nach depth Schnittpunkten ab.
+// Statt einer Rekursion für Reflexionen wird iterativ weiterverfolgt: throughput enthält das Produkt der
+// Spiegelfarben aller bisher getroffenen Objekte und gewichtet die lokale Farbe jedes weiteren Schnittpunkts.
 
-    float distance;
-    Object* hit_obj = find_nearest(ray, distance);
+Vector3df Scene::trace(const Ray3df & ray, int depth) const {
+    Vector3df color = {0.0, 0.0, 0.0};
+    Vector3df throughput = {1.0, 1.0, 1.0};
+    Ray3df current = ray;
+    Hit hit;
 
-    if (hit_obj != nullptr) {
+    for (int bounce = 0; bounce < depth; ++bounce) {
+        if (!find_nearest(current, hit)) {
+            break;
+        }
         // 1. Lokale Farbe berechnen
-        Vector3df local_color = shade(ray, hit_obj, distance);
+        add_product(color, throughput, shade(current, hit));
+
+        // 2. Reflexion verfolgen
+        const Material & mat = materials[objects[hit.object].get_material()];
+        if (!mat.reflective) {
+            break;
+        }
+        throughput = multiply(throughput, mat.mirrorcolour);
+
+        // R = D - 2(N*D)N
+        float dot = current.direction * hit.normal;
+        Vector3df reflect_dir = add_scaled(current.direction, -2.0f * dot, hit.normal);
+        reflect_dir.normalize();
+
+        current = Ray3df{ add_scaled(hit.point, 0.1f, hit.normal), reflect_dir };
+    }
+
+    return color;
+}
+
+
+// Progressives Rendern, damit schnell ein erstes (grobes) Bild zu sehen ist:
+// 1. Grobe Durchgänge: nur jedes stride-te Pixel wird berechnet und auf den ganzen Block kopiert,
+//    stride wird pro Durchgang halbiert, bereits berechnete Pixel werden nicht neu berechnet.
+// 2. Bei stride 1 ist das Bild in voller Auflösung mit einem Sehstrahl pro Pixel fertig.
+// 3. Danach wird pro Durchgang ein zufällig im Pixel verschobener Sehstrahl ergänzt
+//    und der Mittelwert aller Samples angezeigt (stochastisches Supersampling).
+// Das Fenster wird nach jedem Durchgang und spätestens alle UPDATE_INTERVAL während eines Durchgangs aktualisiert.
+
+class ProgressiveRenderer
+{
+  Scene & scene;
+  Camera & camera;
+  Screen & screen;
+  size_t width, height;
+  int depth;
+
+  std::vector<Vector3df> accumulation; // Summe aller Samples je Pixel
+  size_t samples = 0;                  // Anzahl Samples je Pixel in accumulation
+  std::mt19937 random{42};
+  std::chrono::steady_clock::time_point last_update;
+  bool running = true;
+
+  static constexpr std::chrono::milliseconds UPDATE_INTERVAL{50};
+
+  // aktualisiert das Fenster, falls seit dem letzten Mal genug Zeit vergangen ist
+  void update_if_due()
+  {
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_update >= UPDATE_INTERVAL) {
+      running = screen.update();
+      last_update = now;
+    }
+  }
+
+  void fill_block(size_t x0, size_t y0, size_t stride, Vector3df color)
+  {
+    for (size_t y = y0; y < std::min(y0 + stride, height); ++y) {
+      for (size_t x = x0; x < std::min(x0 + stride, width); ++x) {
+        screen.set_pixel(x, y, color);
+      }
+    }
+  }
+
+public:
+  ProgressiveRenderer(Scene & scene, Camera & camera, Screen & screen, int depth)
+    : scene(scene), camera(camera), screen(screen), width(screen.get_width()), height(screen.get_height()), depth(depth)
+  {
+    accumulation.resize(width * height, Vector3df{0.0, 0.0, 0.0});
+  }
+
+  // berechnet jedes stride-te Pixel, das nicht schon im Durchgang mit 2 * stride berechnet wurde
+  // bei stride 1 wird das Ergebnis als erstes Sample in accumulation übernommen
+  void render_coarse(size_t stride, bool first_pass)
+  {
+    for (size_t y = 0; y < height && running; y += stride) {
+      for (size_t x = 0; x < width; x += stride) {
+        size_t index = y * width + x;
+        if (first_pass || x % (2 * stride) != 0 || y % (2 * stride) != 0) {
+          accumulation[index] = scene.trace(camera.get_ray(x, y), depth);
+        }
+        fill_block(x, y, stride, accumulation[index]);
+      }
+      update_if_due();
+    }
+    if (stride == 1) {
+      samples = 1;
+    }
+  }
+
+  // ergänzt jedes Pixel um ein zufällig verschobenes Sample und zeigt den Mittelwert an
+  void render_sample_pass()
+  {
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    samples++;
+    float weight = 1.0f / (float)samples;
+    for (size_t y = 0; y < height && running; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        Ray3df ray = camera.get_ray((float)x + jitter(random), (float)y + jitter(random));
+        size_t index = y * width + x;
+        accumulation[index] += scene.trace(ray, depth);
+        screen.set_pixel(x, y, weight * accumulation[index]);
+      }
+      update_if_due();
+    }
+  }
+
+  // rendert erst grob, dann in voller Auflösung und anschließend sample_passes Supersampling-Durchgänge
+  // bricht ab, sobald das Fenster geschlossen wird; gibt false zurück, falls abgebrochen wurde
+  bool render(size_t coarse_stride, size_t sample_passes)
+  {
+    auto start = std::chrono::steady_clock::now();
+    last_update = start;
+    size_t pass = 0;
+
+    auto finish_pass = [&](const char * name) {
+      running = running && screen.update();
+      last_update = std::chrono::steady_clock::now();
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(last_update - start).count();
+      std::cout << "Durchgang " << pass++ << " (" << name << "): " << ms << " ms" << std::endl;
+    };
+
+    for (size_t stride = coarse_stride; stride >= 1 && running; stride /= 2) {
+      render_coarse(stride, stride == coarse_stride);
+      finish_pass(stride == 1 ? "volle Aufloesung" : "grob");
+    }
+    for (size_t i = 0; i < sample_passes && running; ++i) {
+      render_sample_pass();
+      finish_pass("Supersampling");
+    }
+    return running;
+  }
+};
+
+
+// Adaptives Anti-Aliasing
+// Jedes Pixel bekommt zuerst initial_samples Sehstrahlen. Weitere Sehstrahlen werden nur dort verschossen,
+// wo der Standardfehler der Helligkeit (Luminanz) über error_threshold liegt oder
+// sich die Helligkeit deutlich von einem Nachbarpixel unterscheidet (Kanten).
+// Die Positionen der Sehstrahlen im Pixel stammen aus der Halton-Folge (Basis 2 und 3).
+
+struct SamplingSettings
+{
+  size_t initial_samples = 4;
+  size_t max_samples = 64;
+  float error_threshold = 0.01f;    // maximaler Standardfehler der mittleren Luminanz
+  float contrast_threshold = 0.1f;  // Luminanzunterschied zum Nachbarpixel, ab dem max_samples verwendet werden
+};
+
+float luminance(const Vector3df & color)
+{
+  return 0.2126f * color[0] + 0.7152f * color[1] + 0.0722f * color[2];
+}
 
-        // 2. Reflexion berechnen
-        const Material& mat = hit_obj->get_material();
-        bool is_reflective = (mat.mirrorcolour[0] > 0 || mat.mirrorcolour[1] > 0 || mat.mirrorcolour[2] > 0);
+// Radikalinverse von index zur Basis base, liefert Werte in [0, 1)
+float halton(size_t index, size_t base)
+{
+  float result = 0.0f;
+  float fraction = 1.0f / (float)base;
+  while (index > 0) {
+    result += fraction * (float)(index % base);
+    index /= base;
+    fraction /= (float)base;
+  }
+  return result;
+}
 
-        if (is_reflective) {
-            Vector3df hit_point = ray.origin + (distance * ray.direction);
-            Vector3df normal = hit_point - hit_obj->get_center();
-            normal.normalize();
+// Position des i-ten Samples im Pixel x,y relativ zur Pixelposition, jeweils in [-0.5, 0.5)
+// Die Halton-Punkte werden pro Pixel um einen festen Zufallswert verschoben (Cranley-Patterson-Rotation),
+// damit benachbarte Pixel nicht dasselbe Muster benutzen.
+std::pair<float, float> sample_offset(size_t x, size_t y, size_t i)
+{
+  uint32_t hash = (uint32_t)(x * 73856093u) ^ (uint32_t)(y * 19349663u);
+  hash ^= hash >> 13;
+  hash *= 0x5bd1e995u;
+  hash ^= hash >> 15;
+  float rotation_x = (float)(hash & 0xffffu) / 65536.0f;
+  float rotation_y = (float)(hash >> 16) / 65536.0f;
+
+  float u = halton(i + 1, 2) + rotation_x;
+  float v = halton(i + 1, 3) + rotation_y;
+  return { u - std::floor(u) - 0.5f, v - std::floor(v) - 0.5f };
+}
 
-            // Reflexionsvektor berechnen
-            // Wir nutzen die Formel R = D - 2(N*D)N manuell, falls math.h keine Methode hat
-            float dot = ray.direction * normal;
-            Vector3df reflect_dir = ray.direction - (2.0f * dot * normal);
-            reflect_dir.normalize();
+// Rendert mit samples Sehstrahlen pro Pixel (gleichmäßiges Supersampling)
+std::vector<Vector3df> render_uniform(Scene & scene, Camera & cam, size_t width, size_t height, int depth, size_t samples)
+{
+  std::vector<Vector3df> image(width * height, Vector3df{0.0, 0.0, 0.0});
+  float weight = 1.0f / (float)samples;
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      Vector3df sum = {0.0, 0.0, 0.0};
+      for (size_t i = 0; i < samples; ++i) {
+        auto [u, v] = sample_offset(x, y, i);
+        sum += scene.trace(cam.get_ray((float)x + u, (float)y + v), depth);
+      }
+      image[y * width + x] = weight * sum;
+    }
+  }
+  return image;
+}
 
-            Vector3df reflect_origin = hit_point + (0.1f * normal);
-            Ray3df reflect_ray = { reflect_origin, reflect_dir };
+class AdaptiveSampler
+{
+  // Summe der Farben und laufende Mittelwert-/Varianzberechnung der Luminanz (Welford) je Pixel
+  struct PixelStatistics
+  {
+    Vector3df sum{0.0, 0.0, 0.0};
+    float mean = 0.0f;
+    float m2 = 0.0f;
+    size_t count = 0;
+  };
 
-            // Rekursion
-            Vector3df reflected_color = trace(reflect_ray, depth - 1);
+  Scene & scene;
+  Camera & camera;
+  size_t width, height;
+  int depth;
+  SamplingSettings settings;
+  std::vector<PixelStatistics> statistics;
+  size_t rays = 0;
 
-            // Mischen
-            Vector3df reflection_add = {
-                reflected_color[0] * mat.mirrorcolour[0],
-                reflected_color[1] * mat.mirrorcolour[1],
-                reflected_color[2] * mat.mirrorcolour[2]
-            };
+  void add_sample(size_t x, size_t y)
+  {
+    PixelStatistics & pixel = statistics[y * width + x];
+    auto [u, v] = sample_offset(x, y, pixel.count);
+    Vector3df color = scene.trace(camera.get_ray((float)x + u, (float)y + v), depth);
+    rays++;
+
+    pixel.sum += color;
+    pixel.count++;
+    float l = luminance(color);
+    float delta = l - pixel.mean;
+    pixel.mean += delta / (float)pixel.count;
+    pixel.m2 += delta * (l - pixel.mean);
+  }
+
+  float standard_error(const PixelStatistics & pixel) const
+  {
+    if (pixel.count < 2) {
+      return 0.0f;
+    }
+    float variance = pixel.m2 / (float)(pixel.count - 1);
+    return std::sqrt(variance / (float)pixel.count);
+  }
 
-            return local_color + reflection_add;
+  // true, wenn sich die mittlere Luminanz des Pixels stark von einem der 4 Nachbarn unterscheidet
+  bool is_edge(size_t x, size_t y) const
+  {
+    float l = statistics[y * width + x].mean;
+    auto differs = [&](size_t nx, size_t ny) {
+      return std::abs(statistics[ny * width + nx].mean - l) > settings.contrast_threshold;
+    };
+    return (x > 0 && differs(x - 1, y)) || (x + 1 < width && differs(x + 1, y))
+        || (y > 0 && differs(x, y - 1)) || (y + 1 < height && differs(x, y + 1));
+  }
+
+public:
+  AdaptiveSampler(Scene & scene, Camera & camera, size_t width, size_t height, int depth, SamplingSettings settings = {})
+    : scene(scene), camera(camera), width(width), height(height), depth(depth), settings(settings) { }
+
+  std::vector<Vector3df> render()
+  {
+    statistics.assign(width * height, PixelStatistics{});
+    rays = 0;
+
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        for (size_t i = 0; i < settings.initial_samples; ++i) {
+          add_sample(x, y);
         }
+      }
+    }
+
+    // Kanten werden vor dem Nachsampeln bestimmt, damit das Ergebnis nicht von der Reihenfolge der Pixel abhängt
+    std::vector<bool> edges(width * height);
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        edges[y * width + x] = is_edge(x, y);
+      }
+    }
+
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        size_t index = y * width + x;
+        if (edges[index]) {
+          while (statistics[index].count < settings.max_samples) {
+            add_sample(x, y);
+          }
+        } else {
+          while (statistics[index].count < settings.max_samples && standard_error(statistics[index]) > settings.error_threshold) {
+            for (size_t i = 0; i < settings.initial_samples; ++i) {
+              add_sample(x, y);
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<Vector3df> image(width * height, Vector3df{0.0, 0.0, 0.0});
+    for (size_t i = 0; i < image.size(); ++i) {
+      image[i] = (1.0f / (float)statistics[i].count) * statistics[i].sum;
+    }
+    return image;
+  }
+
+  // Anzahl der Sehstrahlen (ohne Schatten- und Reflexionsstrahlen) beim letzten render()
+  size_t get_ray_count() const
+  {
+    return rays;
+  }
+};
+
+// Wurzel der mittleren quadratischen Abweichung aller Farbanteile
+float rmse(const std::vector<Vector3df> & image, const std::vector<Vector3df> & reference)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < image.size(); ++i) {
+    sum += (image[i] - reference[i]).square_of_length();
+  }
+  return (float)std::sqrt(sum / (3.0 * (double)image.size()));
+}
+
+// Vergleicht gleichmäßiges Supersampling mit N Samples und adaptives Anti-Aliasing für verschiedene Schwellwerte
+// auf der Cornell-Box. Ausgegeben werden Sehstrahlen pro Pixel, Zeit und Abweichung (RMSE) zu einem Referenzbild
+// mit REFERENCE_SAMPLES Samples pro Pixel.
+void report_antialiasing(size_t width, size_t height, int depth)
+{
+  constexpr size_t REFERENCE_SAMPLES = 256;
+  Scene scene = create_cornell_box();
+  Camera cam(Vector3df{0.0f,0.0f,0.0f}, Vector3df{0.0f,0.0f,-1.0f}, Vector3df{0.0f,1.0f,0.0f}, width, height, 2.0f / (float)width);
+  double pixel_count = (double)(width * height);
+
+  std::vector<Vector3df> reference = render_uniform(scene, cam, width, height, depth, REFERENCE_SAMPLES);
+
+  auto print = [&](const std::string & mode, double rays_per_pixel, long long ms, float error) {
+    std::cout << mode << "\t" << rays_per_pixel << "\t" << ms << "\t" << error << std::endl;
+  };
+  std::cout << "Verfahren\tStrahlen/Pixel\tZeit [ms]\tRMSE" << std::endl;
+
+  for (size_t samples : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Vector3df> image = render_uniform(scene, cam, width, height, depth, samples);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    print("uniform " + std::to_string(samples), (double)samples, ms, rmse(image, reference));
+  }
+
+  for (float threshold : {0.2f, 0.1f, 0.05f, 0.02f}) {
+    SamplingSettings settings;
+    settings.contrast_threshold = threshold;
+    settings.error_threshold = 0.1f * threshold;
+    AdaptiveSampler sampler(scene, cam, width, height, depth, settings);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Vector3df> image = sampler.render();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    print("adaptiv " + std::to_string(threshold), (double)sampler.get_ray_count() / pixel_count, ms, rmse(image, reference));
+  }
+}
 
-        return local_color;
+// Berechnet für jedes Pixel einen Sehstrahl und setzt die Farbe beim Bildschirm
+// mit adaptive wird stattdessen mit adaptivem Anti-Aliasing gerendert (siehe AdaptiveSampler)
+void render(Scene & scene, Camera & cam, Screen & screen, int depth, bool adaptive = false)
+{
+  if (adaptive) {
+    AdaptiveSampler sampler(scene, cam, screen.get_width(), screen.get_height(), depth);
+    std::vector<Vector3df> image = sampler.render();
+    for (size_t y = 0; y < screen.get_height(); ++y) {
+      for (size_t x = 0; x < screen.get_width(); ++x) {
+        screen.set_pixel(x, y, image[y * screen.get_width() + x]);
+      }
+    }
+    return;
+  }
+  for (size_t y = 0; y < screen.get_height(); ++y) {
+    for (size_t x = 0; x < screen.get_width(); ++x) {
+      
+      Ray3df ray = cam.get_ray(x, y);
+      
+      Vector3df pixel_color = scene.trace(ray, depth);
+
+      screen.set_pixel(x, y, pixel_color);
     }
+  }
+}
+
+
+// Szenen und Kameras, die über die Kommandozeile ausgewählt werden können
+std::map<std::string, std::function<Scene()>> scene_factories = {
+  {"cornell", create_cornell_box}
+};
+
+// Augenpunkt und Blickpunkt der Kamera, oben ist immer die y-Achse
+std::map<std::string, std::pair<Vector3df, Vector3df>> camera_presets = {
+  {"front", {Vector3df{ 0.0f, 0.0f,  0.0f}, Vector3df{0.0f,  0.0f, -1.0f}}},
+  {"left",  {Vector3df{-1.2f, 0.5f,  0.0f}, Vector3df{0.0f, -0.5f, -5.0f}}},
+  {"right", {Vector3df{ 1.2f, 0.5f,  0.0f}, Vector3df{0.0f, -0.5f, -5.0f}}},
+  {"top",   {Vector3df{ 0.0f, 1.5f, -1.0f}, Vector3df{0.0f, -1.0f, -5.0f}}}
+};
 
-    return Vector3df{0.0, 0.0, 0.0};
+Camera create_camera(const std::string & preset, size_t width, size_t height)
+{
+  auto [eye, look_at] = camera_presets.at(preset);
+  // die Bildebene ist unabhängig von der Auflösung immer 2 Einheiten breit
+  return Camera(eye, look_at, Vector3df{0.0f,1.0f,0.0f}, width, height, 2.0f / (float)width);
+}
+
+
+// Ein Auftrag für das Rendern ohne Fenster: Szene und Kamera werden in die Datei output geschrieben.
+// Auf der Kommandozeile als szene:kamera:datei angegeben, die Endung der Datei (.ppm oder .pfm) bestimmt das Format.
+struct RenderJob
+{
+  std::string scene;
+  std::string camera;
+  std::string output;
+};
+
+// Rendert alle Aufträge nacheinander ohne Fenster.
+// Jede Szene wird nur einmal aufgebaut und für alle folgenden Aufträge mit dieser Szene wiederverwendet.
+// Gibt 0 zurück, wenn alle Bilder geschrieben wurden.
+int render_batch(const std::vector<RenderJob> & jobs, size_t width, size_t height, int depth, bool adaptive)
+{
+  std::map<std::string, Scene> scenes;
+  Screen screen(width, height, true);
+  int result = 0;
+
+  for (const RenderJob & job : jobs) {
+    if (scene_factories.find(job.scene) == scene_factories.end()) {
+      std::cerr << "Unbekannte Szene: " << job.scene << std::endl;
+      result = 1;
+      continue;
+    }
+    if (camera_presets.find(job.camera) == camera_presets.end()) {
+      std::cerr << "Unbekannte Kamera: " << job.camera << std::endl;
+      result = 1;
+      continue;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto entry = scenes.find(job.scene);
+    if (entry == scenes.end()) {
+      entry = scenes.emplace(job.scene, scene_factories.at(job.scene)()).first;
+    }
+    Camera cam = create_camera(job.camera, width, height);
+
+    render(entry->second, cam, screen, depth, adaptive);
+
+    bool pfm = job.output.size() >= 4 && job.output.compare(job.output.size() - 4, 4, ".pfm") == 0;
+    bool written = pfm ? screen.write_pfm(job.output) : screen.write_ppm(job.output);
+    if (!written) {
+      std::cerr << "Konnte " << job.output << " nicht schreiben" << std::endl;
+      result = 1;
+      continue;
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << job.scene << ":" << job.camera << " -> " << job.output << ": " << ms << " ms" << std::endl;
+  }
+  return result;
+}
+
+
+// Misst die Renderzeit der Cornell-Box für die Rekursionstiefen 1 bis max_depth
+// je Tiefe wird die beste von mehreren Wiederholungen ausgegeben
+void benchmark_depth(size_t width, size_t height, int max_depth)
+{
+  constexpr int REPETITIONS = 5;
+  Scene scene = create_cornell_box();
+  Camera cam = create_camera("front", width, height);
+  Screen screen(width, height, true);
+
+  std::cout << "Tiefe\tZeit [ms]" << std::endl;
+  for (int depth = 1; depth <= max_depth; ++depth) {
+    double best = 1e30;
+    for (int i = 0; i < REPETITIONS; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      render(scene, cam, screen, depth);
+      std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+      best = std::min(best, ms.count());
+    }
+    std::cout << depth << "\t" << best << std::endl;
+  }
+}
+
+void print_usage(const char * program)
+{
+  std::cerr << "Aufruf: " << program << " [--progressive | --aa | --aa-report | --bench-depth] [--size BREITExHOEHE] [--depth TIEFE] [szene:kamera:datei ...]\n"
+            << "  ohne Auftraege wird die Cornell-Box im Fenster angezeigt,\n"
+            << "  mit Auftraegen wird ohne Fenster in PPM- oder PFM-Dateien gerendert.\n"
+            << "  --aa verwendet adaptives Anti-Aliasing, --aa-report vergleicht es mit gleichmaessigem Supersampling.\n"
+            << "  --bench-depth misst die Renderzeit fuer die Rekursionstiefen 1 bis TIEFE.\n"
+            << "  Szenen: cornell, Kameras: front, left, right, top" << std::endl;
 }
 
 
@@ -434,26 +1056,79 @@ Vector3df Scene::trace(Ray3df ray, int depth) {
   //   Sehstrahl für x,y mit Kamera erzeugen
   //   Farbe mit raytracing-Methode bestimmen
   //   Beim Bildschirm die Farbe für Pixel x,y, setzten
+  // Mit --progressive wird stattdessen progressiv gerendert (siehe ProgressiveRenderer)
+  // Werden Aufträge übergeben, wird ohne Fenster gerendert (siehe render_batch)
+  // Mit --aa wird adaptives Anti-Aliasing verwendet, --aa-report gibt nur den Vergleich mit Supersampling aus
+  // --bench-depth gibt die Renderzeiten je Rekursionstiefe aus
 
-int main(void) {
+int main(int argc, char ** argv) {
   size_t width = 400;
   size_t height = 400;
+  int depth = 5;
+  bool progressive = false;
+  bool adaptive = false;
+  bool aa_report = false;
+  bool bench_depth = false;
+  std::vector<RenderJob> jobs;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--progressive") {
+      progressive = true;
+    } else if (arg == "--aa") {
+      adaptive = true;
+    } else if (arg == "--aa-report") {
+      aa_report = true;
+    } else if (arg == "--bench-depth") {
+      bench_depth = true;
+    } else if (arg == "--size" && i + 1 < argc) {
+      if (std::sscanf(argv[++i], "%zux%zu", &width, &height) != 2 || width == 0 || height == 0) {
+        print_usage(argv[0]);
+        return 1;
+      }
+    } else if (arg == "--depth" && i + 1 < argc) {
+      depth = std::atoi(argv[++i]);
+    } else {
+      size_t first = arg.find(':');
+      size_t second = arg.find(':', first + 1);
+      if (first == std::string::npos || second == std::string::npos) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      jobs.push_back(RenderJob{arg.substr(0, first), arg.substr(first + 1, second - first - 1), arg.substr(second + 1)});
+    }
+  }
+
+  if (bench_depth) {
+    benchmark_depth(width, height, depth);
+    return 0;
+  }
+
+  if (aa_report) {
+    report_antialiasing(width, height, depth);
+    return 0;
+  }
+
+  if (!jobs.empty()) {
+    return render_batch(jobs, width, height, depth, adaptive);
+  }
+
   Screen screen(width, height);
 
-  Camera cam(Vector3df{0.0f,0.0f,0.0f}, Vector3df{0.0f,0.0f,-1.0f}, Vector3df{0.0f,1.0f,0.0f}, width, height, 0.005f);
+  Camera cam = create_camera("front", width, height);
 
   Scene scene = create_cornell_box();
 
-  for (size_t y = 0; y < height; ++y) {
-    for (size_t x = 0; x < width; ++x) {
-      
-      Ray3df ray = cam.get_ray(x, y);
-      
-      Vector3df pixel_color = scene.trace(ray, 5);
-
-      screen.set_pixel(x, y, pixel_color);
+  if (progressive) {
+    ProgressiveRenderer progressive_renderer(scene, cam, screen, depth);
+    if (!progressive_renderer.render(16, 16)) {
+      return 0; // Fenster wurde während des Renderns geschlossen
     }
+    screen.show();
+    return 0;
   }
+
+  render(scene, cam, screen, depth, adaptive);
   screen.show();
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,137 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wavefront.h"
+
+// A binary cache of a Wavefront OBJ file that can be passed to glBufferData without any conversion.
+// The cache of model.obj is stored as model.mesh and is rebuilt if the OBJ file or one of its
+//   material files changes (size or modification time, or a missing one appears), the format version
+//   changes or the cache is damaged.
+// Layout (native byte order, every section starts at a multiple of 64 bytes):
+//   MeshCacheHeader
+//   sources:        per source file a MeshCacheSource followed by its path, padded to 8 bytes
+//   materials:      MeshCacheMaterial
+//   ranges:         MeshCacheRange, the triangles of one material
+//   vertices:       9 floats per vertex: position, normal, color of the material
+//   indices:        uint32_t, three per triangle
+//   nodes:          MeshCacheNode, a bounding volume hierarchy over the triangles
+//   node_triangles: uint32_t, the triangles of the leaves
+//   lods:           MeshCacheLod, simplified versions of the mesh with fewer triangles
+//   lod_indices:    uint32_t, three per triangle of the lods, into the same vertices
+
+const uint32_t MESH_CACHE_VERSION = 4;
+const size_t MESH_CACHE_FLOATS_PER_VERTEX = 9;
+
+struct MeshCacheSection {
+  uint64_t offset; // in bytes from the start of the file
+  uint64_t count;  // number of elements
+};
+
+struct MeshCacheHeader {
+  char magic[8];       // "A7MESH"
+  uint32_t version;    // MESH_CACHE_VERSION
+  uint32_t byte_order; // 0x01020304 as written
+  MeshCacheSection sources;
+  MeshCacheSection materials;
+  MeshCacheSection ranges;
+  MeshCacheSection vertices;
+  MeshCacheSection indices;
+  MeshCacheSection nodes;
+  MeshCacheSection node_triangles;
+  MeshCacheSection lods;
+  MeshCacheSection lod_indices;
+  float bounds_min[3]; // bounding box of all vertices
+  float bounds_max[3];
+};
+
+struct MeshCacheSource {
+  // the file did not exist when the cache was written
+  static constexpr uint64_t ABSENT_SIZE = UINT64_MAX;
+  static constexpr int64_t ABSENT_MODIFIED = INT64_MIN;
+
+  uint64_t size;
+  int64_t modified;     // std::filesystem::last_write_time, in ticks of its clock
+  uint32_t path_length;
+  uint32_t padding;
+};
+
+struct MeshCacheMaterial {
+  char name[52]; // truncated, terminated by '\0'
+  Color ambient;
+};
+
+struct MeshCacheRange {
+  static constexpr uint32_t NO_MATERIAL = UINT32_MAX; // drawn with the default color white
+
+  uint32_t first; // indices[first, first + count)
+  uint32_t count;
+  uint32_t material;
+};
+
+// count == 0: inner node with the children nodes[first] and nodes[first + 1]
+// count > 0: leaf with the triangles node_triangles[first, first + count)
+struct MeshCacheNode {
+  float min[3];
+  float max[3];
+  uint32_t first;
+  uint32_t count;
+};
+
+// a level of detail: the triangles lod_indices[first, first + count) approximate the mesh,
+//   error is about the largest distance between them and the mesh (in the units of the model)
+// the lods of a mesh have less triangles and a larger error one after another
+struct MeshCacheLod {
+  uint32_t first;
+  uint32_t count;
+  float error;
+};
+
+// the cache of an OBJ file, mapped into memory
+class CachedMesh {
+  std::optional<MappedFile> file;
+  std::string created; // the cache if it had to be created
+  std::string_view data;
+  bool was_created = false;
+
+  template <class ELEMENT>
+  std::span<const ELEMENT> section(const MeshCacheSection & section) const;
+public:
+  // maps the cache of the OBJ file at obj_path; if there is no valid cache, the OBJ file is parsed
+  //   and the cache is written (if that fails, the cache is only kept in memory)
+  // if the OBJ file does not exist, the mesh is empty
+  explicit CachedMesh(const std::string & obj_path);
+  CachedMesh(const CachedMesh &) = delete;
+  CachedMesh & operator=(const CachedMesh &) = delete;
+
+  // the path of the cache of obj_path: the extension is replaced by .mesh
+  static std::string cache_path(const std::string & obj_path);
+
+  // creates the cache for importer after parse_indexed(); sources are the OBJ file and its material files
+  static std::string create(WavefrontImporter & importer, const std::vector<std::string> & sources);
+
+  // true if data is a complete cache of the current version, its sources have not changed and
+  //   all indices and ranges are inside their sections (every index is read once)
+  static bool is_valid(std::string_view data);
+
+  // true if the OBJ file had to be parsed
+  bool is_created() const;
+
+  const MeshCacheHeader & get_header() const;
+  std::span<const float> get_vertices() const;
+  std::span<const uint32_t> get_indices() const;
+  std::span<const MeshCacheMaterial> get_materials() const;
+  std::span<const MeshCacheRange> get_ranges() const;
+  std::span<const MeshCacheNode> get_nodes() const;
+  std::span<const uint32_t> get_node_triangles() const;
+  std::span<const MeshCacheLod> get_lods() const;
+  std::span<const uint32_t> get_lod_indices() const;
+};
+
+#endif
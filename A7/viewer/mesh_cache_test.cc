@@ -0,0 +1,215 @@
+#include "mesh_cache.h"
+#include <filesystem>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// a copy of the OBJ file in a temporary folder, without a cache
+std::string copy_to_temporary(const std::string & file) {
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "mesh_cache_test";
+  std::filesystem::create_directories(folder);
+  const std::filesystem::path copy = folder / file;
+  std::filesystem::copy_file(file, copy, std::filesystem::copy_options::overwrite_existing);
+  std::filesystem::remove(CachedMesh::cache_path(copy.string()));
+  return copy.string();
+}
+
+TEST(MESH_CACHE, CachePath) {
+  ASSERT_EQ("models/teapot.mesh", CachedMesh::cache_path("models/teapot.obj"));
+}
+
+// the cache holds the triangles of the Face output with the colors of their materials
+TEST(MESH_CACHE, CreatedOnceThenMapped) {
+  for (const std::string file : {"teapot.obj", "space_ship.obj", "ufo.obj"}) {
+    const std::string path = copy_to_temporary(file);
+    CachedMesh created(path);
+    ASSERT_TRUE(created.is_created());
+    ASSERT_TRUE(std::filesystem::exists(CachedMesh::cache_path(path)));
+    CachedMesh mapped(path);
+    ASSERT_FALSE(mapped.is_created());
+    ASSERT_TRUE(std::equal(created.get_vertices().begin(), created.get_vertices().end(),
+                           mapped.get_vertices().begin(), mapped.get_vertices().end()));
+    ASSERT_TRUE(std::equal(created.get_indices().begin(), created.get_indices().end(),
+                           mapped.get_indices().begin(), mapped.get_indices().end()));
+
+    WavefrontImporter importer;
+    importer.parse_file(path);
+    const std::vector<Face> & faces = importer.get_faces();
+    std::span<const float> vertices = mapped.get_vertices();
+    std::span<const uint32_t> indices = mapped.get_indices();
+    ASSERT_EQ(3 * faces.size(), indices.size()) << file;
+    for (size_t i = 0; i < faces.size(); i++) {
+      const Color color = faces[i].material == nullptr ? Color{1.0f, 1.0f, 1.0f} : faces[i].material->ambient;
+      for (size_t j = 0; j < 3; j++) {
+        const float * vertex = &vertices[indices[3 * i + j] * MESH_CACHE_FLOATS_PER_VERTEX];
+        const ReferenceGroup & group = faces[i].reference_groups[j];
+        ASSERT_EQ(group.vertice, (Vertice{vertex[0], vertex[1], vertex[2]}));
+        ASSERT_EQ(group.normal, (Normal{vertex[3], vertex[4], vertex[5]}));
+        ASSERT_EQ(color, (Color{vertex[6], vertex[7], vertex[8]}));
+      }
+    }
+    uint32_t ranges_count = 0;
+    for (const MeshCacheRange & range : mapped.get_ranges()) {
+      ASSERT_EQ(ranges_count, range.first);
+      ranges_count += range.count;
+    }
+    ASSERT_EQ(indices.size(), ranges_count);
+  }
+}
+
+TEST(MESH_CACHE, RebuiltIfSourceChanges) {
+  const std::string path = copy_to_temporary("torpedo.obj");
+  CachedMesh first(path);
+  ASSERT_TRUE(first.is_created());
+  const size_t triangles = first.get_indices().size() / 3;
+
+  std::ofstream(path, std::ios::app) << "f 1 2 3\n";
+  CachedMesh changed(path);
+  ASSERT_TRUE(changed.is_created());
+  ASSERT_EQ(triangles + 1, changed.get_indices().size() / 3);
+  ASSERT_FALSE(CachedMesh(path).is_created());
+
+  // another version
+  {
+    std::fstream cache(CachedMesh::cache_path(path), std::ios::in | std::ios::out | std::ios::binary);
+    const uint32_t version = MESH_CACHE_VERSION + 1;
+    cache.seekp(offsetof(MeshCacheHeader, version));
+    cache.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  }
+  ASSERT_TRUE(CachedMesh(path).is_created());
+
+  // truncated
+  std::filesystem::resize_file(CachedMesh::cache_path(path), 200);
+  ASSERT_TRUE(CachedMesh(path).is_created());
+}
+
+// a cache with an index or a range outside of its sections is not mapped, the OBJ file is parsed again
+TEST(MESH_CACHE, RebuiltIfDamaged) {
+  const std::string path = copy_to_temporary("torpedo.obj");
+  const MeshCacheHeader header = CachedMesh(path).get_header();
+  const auto damage = [&path](uint64_t offset, uint32_t value) {
+    std::fstream cache(CachedMesh::cache_path(path), std::ios::in | std::ios::out | std::ios::binary);
+    cache.seekp(static_cast<std::streamoff>(offset));
+    cache.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  ASSERT_FALSE(CachedMesh(path).is_created());
+
+  damage(header.indices.offset + 4 * (header.indices.count - 1), static_cast<uint32_t>(header.vertices.count));
+  ASSERT_TRUE(CachedMesh(path).is_created());
+  ASSERT_FALSE(CachedMesh(path).is_created());
+
+  damage(header.ranges.offset + offsetof(MeshCacheRange, count), static_cast<uint32_t>(header.indices.count + 1));
+  ASSERT_TRUE(CachedMesh(path).is_created());
+
+  damage(header.ranges.offset + offsetof(MeshCacheRange, material), static_cast<uint32_t>(header.materials.count));
+  ASSERT_TRUE(CachedMesh(path).is_created());
+
+  damage(header.nodes.offset + offsetof(MeshCacheNode, first), static_cast<uint32_t>(header.node_triangles.count));
+  ASSERT_TRUE(CachedMesh(path).is_created());
+  ASSERT_FALSE(CachedMesh(path).is_created());
+}
+
+// a material file that is missing when the cache is written invalidates it when it appears
+TEST(MESH_CACHE, RebuiltIfMaterialLibraryAppears) {
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "mesh_cache_test";
+  std::filesystem::create_directories(folder);
+  const std::string library = (folder / "appearing.mtl").string();
+  const std::string path = (folder / "appearing.obj").string();
+  std::filesystem::remove(library);
+  std::filesystem::remove(CachedMesh::cache_path(path));
+  std::ofstream(path) << "mtllib " << library << "\nv 0 0 0\nv 1 0 0\nv 0 1 0\nusemtl red\nf 1 2 3\n";
+
+  CachedMesh without(path);
+  ASSERT_TRUE(without.is_created());
+  ASSERT_EQ(0, without.get_materials().size());
+  ASSERT_FALSE(CachedMesh(path).is_created());
+
+  std::ofstream(library) << "newmtl red\nKd 1 0 0\n";
+  CachedMesh with(path);
+  ASSERT_TRUE(with.is_created());
+  ASSERT_EQ(1, with.get_materials().size());
+  ASSERT_EQ((Color{1.0f, 0.0f, 0.0f}), (Color{with.get_vertices()[6], with.get_vertices()[7], with.get_vertices()[8]}));
+  ASSERT_FALSE(CachedMesh(path).is_created());
+}
+
+TEST(MESH_CACHE, MissingObj) {
+  CachedMesh mesh("does_not_exist.obj");
+  ASSERT_TRUE(mesh.is_created());
+  ASSERT_EQ(0, mesh.get_indices().size());
+  ASSERT_EQ(0, mesh.get_nodes().size());
+  ASSERT_FALSE(std::filesystem::exists("does_not_exist.mesh"));
+}
+
+// every triangle is in exactly one leaf, the boxes contain their triangles and child nodes
+TEST(MESH_CACHE, BoundingVolumeHierarchy) {
+  const std::string path = copy_to_temporary("teapot.obj");
+  CachedMesh mesh(path);
+  std::span<const MeshCacheNode> nodes = mesh.get_nodes();
+  std::span<const float> vertices = mesh.get_vertices();
+  std::span<const uint32_t> indices = mesh.get_indices();
+  ASSERT_LT(0, nodes.size());
+  for (size_t axis = 0; axis < 3; axis++) {
+    ASSERT_EQ(mesh.get_header().bounds_min[axis], nodes[0].min[axis]);
+    ASSERT_EQ(mesh.get_header().bounds_max[axis], nodes[0].max[axis]);
+  }
+
+  std::vector<int> found(indices.size() / 3, 0);
+  for (const MeshCacheNode & node : nodes) {
+    if (node.count == 0) {
+      for (const MeshCacheNode & child : {nodes[node.first], nodes[node.first + 1]}) {
+        for (size_t axis = 0; axis < 3; axis++) {
+          ASSERT_LE(node.min[axis], child.min[axis]);
+          ASSERT_GE(node.max[axis], child.max[axis]);
+        }
+      }
+      continue;
+    }
+    for (uint32_t triangle : mesh.get_node_triangles().subspan(node.first, node.count)) {
+      found.at(triangle)++;
+      for (size_t corner = 0; corner < 3; corner++) {
+        const float * position = &vertices[indices[3 * triangle + corner] * MESH_CACHE_FLOATS_PER_VERTEX];
+        for (size_t axis = 0; axis < 3; axis++) {
+          ASSERT_LE(node.min[axis], position[axis]);
+          ASSERT_GE(node.max[axis], position[axis]);
+        }
+      }
+    }
+  }
+  ASSERT_EQ(std::vector<int>(found.size(), 1), found);
+}
+
+
+// every lod has at most half the triangles of the one before, a larger error, and the same vertices
+TEST(MESH_CACHE, LevelsOfDetail) {
+  for (const std::string file : {"teapot.obj", "ufo.obj"}) {
+    CachedMesh mesh(copy_to_temporary(file));
+    std::span<const MeshCacheLod> lods = mesh.get_lods();
+    std::span<const uint32_t> lod_indices = mesh.get_lod_indices();
+    ASSERT_LT(0, lods.size()) << file;
+    size_t count = mesh.get_indices().size();
+    float error = 0.0f;
+    uint32_t first = 0;
+    for (const MeshCacheLod & lod : lods) {
+      ASSERT_EQ(first, lod.first);
+      ASSERT_EQ(0, lod.count % 3);
+      ASSERT_LE(2 * lod.count / 3, count / 3);
+      ASSERT_LE(error, lod.error);
+      for (uint32_t index : lod_indices.subspan(lod.first, lod.count)) {
+        ASSERT_LT(index, mesh.get_header().vertices.count);
+      }
+      first += lod.count;
+      count = lod.count;
+      error = lod.error;
+    }
+    ASSERT_EQ(first, lod_indices.size());
+  }
+
+  // the first lod of the teapot hardly differs from it
+  CachedMesh teapot(copy_to_temporary("teapot.obj"));
+  const MeshCacheHeader & header = teapot.get_header();
+  ASSERT_LT(teapot.get_lods()[0].error, 0.01f * (header.bounds_max[0] - header.bounds_min[0]));
+}
+
+}
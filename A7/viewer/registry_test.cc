@@ -0,0 +1,59 @@
+#include "registry.h"
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(REGISTRY, InternOnce) {
+  Registry<int> registry;
+  ASSERT_TRUE(registry.empty());
+  const Handle<int> red = registry.intern("red");
+  const Handle<int> blue = registry.intern(std::string("blue"));
+  ASSERT_EQ(0, red.index);
+  ASSERT_EQ(1, blue.index);
+  ASSERT_TRUE(red == registry.intern("red"));
+  ASSERT_TRUE(blue == registry.find("blue"));
+  ASSERT_EQ(2, registry.size());
+  ASSERT_EQ("red", registry.name(red));
+  ASSERT_EQ(0, registry[red]);
+  registry[red] = 7;
+  ASSERT_EQ(7, registry.at("red"));
+  ASSERT_EQ(&registry[blue], registry.get(blue));
+}
+
+TEST(REGISTRY, UnknownName) {
+  Registry<int> registry;
+  registry.intern("red");
+  ASSERT_FALSE(registry.find("green").is_valid());
+  ASSERT_FALSE(Handle<int>().is_valid());
+  ASSERT_EQ(nullptr, registry.get(registry.find("green")));
+  ASSERT_THROW(registry.at("green"), std::out_of_range);
+  ASSERT_EQ(1, registry.size());
+}
+
+// pointers to the values stay valid while further names are interned
+TEST(REGISTRY, StableReferences) {
+  Registry<std::string> registry;
+  std::string * first = &registry[registry.intern("0")];
+  *first = "first";
+  for (int i = 1; i < 10000; i++) {
+    registry[registry.intern(std::to_string(i))] = std::to_string(i);
+  }
+  ASSERT_EQ(first, &registry.at("0"));
+  ASSERT_EQ("first", *first);
+  ASSERT_EQ("9999", registry[registry.find("9999")]);
+}
+
+// a copy has its own values under the same handles
+TEST(REGISTRY, Copy) {
+  Registry<int> registry;
+  registry[registry.intern("red")] = 1;
+  Registry<int> copy = registry;
+  copy.at("red") = 2;
+  ASSERT_EQ(1, registry.at("red"));
+  ASSERT_EQ(2, copy[copy.find("red")]);
+  ASSERT_TRUE(registry.find("red") == copy.find("red"));
+}
+
+}
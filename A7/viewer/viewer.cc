@@ -7,6 +7,7 @@
 #include <fstream>
 #include <array>
 #include "wavefront.h"
+#include "mesh_cache.h"
 #include "debug.h"
 
 const int window_width = 1024;
@@ -149,7 +150,7 @@ void switch_background_color() {
 // view assumes the vertices are in canonical coordinates
 // view direction is along the -z axis
 // scale can be used to scale the coordinates up or down to canonical coords.
-void view(std::vector<float> & vertices, float scale) {
+void view(const CachedMesh & mesh, float scale) {
   static float PI = 3.1415f;
   
   glClearColor ( 0.5, 0.5, 0.5, 1.0 );
@@ -168,10 +169,18 @@ void view(std::vector<float> & vertices, float scale) {
   glGenBuffers(1, &vbo); // create a new vertex buffer object (VBO)
   glBindBuffer(GL_ARRAY_BUFFER, vbo); // make it active  
   
-  // transfer data from RAM to GPU buffer
+  // transfer data from the mapped cache file to GPU buffer
   glBufferData(GL_ARRAY_BUFFER,
-               vertices.size() * sizeof(float), 
-               vertices.data(),
+               mesh.get_vertices().size_bytes(),
+               mesh.get_vertices().data(),
+               GL_STATIC_DRAW);
+
+  GLuint ebo;
+  glGenBuffers(1, &ebo); // the indices of the triangles, stored in the vao
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               mesh.get_indices().size_bytes(),
+               mesh.get_indices().data(),
                GL_STATIC_DRAW);
 
   /* the following layout is assumed for each vertex of a face (triangle)
@@ -218,7 +227,7 @@ void view(std::vector<float> & vertices, float scale) {
 
     GLint uniformView = glGetUniformLocation (shaderProgram, "model");
     glUniformMatrix4fv(uniformView, 1 , GL_FALSE , glm::value_ptr(model) ) ;  
-    glDrawArrays(GL_TRIANGLES, 0, vertices.size() / 9);
+    glDrawElements(GL_TRIANGLES, mesh.get_indices().size(), GL_UNSIGNED_INT, (void*)0);
     swap_window();
   
     delay(100);
@@ -227,39 +236,6 @@ void view(std::vector<float> & vertices, float scale) {
 }
 
 
-Material default_material = { {1.0f, 1.0f, 1.0f} };
-
-/* assumes that the all i faces are triangles, more than three vertices of a face are ignored
-   creates a vector of floats with the following layout
-   [ face1 | face2 | ... | facei ]
-   where each face consists of a sequence of 3 (=number of triangle vertices) * 9 floats
-   x1 y1 z1 nx1 ny1 nz1 r1 g1 b1 | x2 y2 z2 nx2 ny2 nz2 r2 g2 b2 | x3 y3 z3 nx3 ny3 nz3 r3 g3 b3
-     vertex   normal     color       vertex    normal     color     vertex    normal     color
-     
-  if no material is given for a face, then the default_material is used
-  
-  if you want to use other layouts, then adapt this code
-*/     
-std::vector<float> create_vertices(WavefrontImporter & wi) {
-  std::vector<float> vertices;
-  
-  for (Face face : wi.get_faces() ) {
-    for (ReferenceGroup group : face.reference_groups ) {
-      for (size_t i = 0; i < 3; i++) {
-        vertices.push_back( group.vertice[i]);
-      }
-      for (size_t i = 0; i < 3; i++) {
-        vertices.push_back( group.normal[i] );
-      }
-      if (face.material == nullptr) face.material = &default_material;
-      for (size_t i = 0; i < 3; i++) {
-        vertices.push_back( face.material->ambient[i]);
-      }
-    } 
-  }
-  return vertices;
-}
-
 int main(int , char** ) {
     // Teapot (Standard)
 /*     std::string obj_path = "teapot.obj";
@@ -282,13 +258,12 @@ int main(int , char** ) {
     std::string mtl_path = "ufo.mtl"; */
 
 
-    std::fstream in(obj_path);
-    WavefrontImporter wi(in);
-  wi.parse();
-  std::vector<float> vertices = create_vertices(wi);
+  // parses the obj file only if it has changed since the last start,
+  // faces without material are white
+  CachedMesh mesh(obj_path);
   init();
   create_shaders();   
-  view(vertices, 0.25f); // adapt the scale factor to the objects local coordinates
+  view(mesh, 0.25f); // adapt the scale factor to the objects local coordinates
                          // such that the scaled vertex coordinates fit into the canonical box [-1,1]^3
   exit();
   
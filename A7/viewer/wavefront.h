@@ -2,12 +2,18 @@
 #define WAVEFRONT_H
 
 #include <fstream>
+#include <functional>
+#include <span>
 #include <vector>
 #include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 
 #include "debug.h"
+#include "registry.h"
 
 typedef std::array<float, 3> Vertice;
 typedef std::array<float, 3> Normal;
@@ -18,6 +24,9 @@ struct Material {
   Color ambient;
 };
 
+// a material of WavefrontImporter::get_materials()
+typedef Handle<Material> MaterialHandle;
+
 struct ReferenceGroup {
   Vertice vertice;
   Normal normal;
@@ -27,19 +36,68 @@ struct ReferenceGroup {
 // the form a polygon if the are all oriented clock- or counter-clock-wise
 struct Face {
   std::vector<ReferenceGroup> reference_groups;
-  Material * material; // optional material information
+  Material * material = nullptr; // optional material information
+};
+
+// a triangle of parse_batches(), without allocations
+struct BatchTriangle {
+  std::array<ReferenceGroup, 3> corners;
+  Material * material = nullptr;
+};
+
+// all faces of a file as triangles with shared vertices, ready for a vertex and an index buffer
+// positions[i] and normals[i] form the vertex i, every (vertex, normal) pair of the file occurs once,
+//   faces without normals get calculated normals (see WavefrontImporter::set_crease_angle())
+// indices holds three vertices per triangle, in the order of the faces in the file
+struct IndexedMesh {
+  // the triangles indices[first, first + count) have the same material
+  struct MaterialRange {
+    MaterialHandle material; // invalid if no material is set
+    uint32_t first;
+    uint32_t count;
+  };
+
+  std::vector<Vertice> positions;
+  std::vector<Normal> normals;
+  std::vector<uint32_t> indices;
+  std::vector<MaterialRange> material_ranges; // consecutive faces with the same material form one range
 };
 
+// a read-only file mapped into memory (with mmap, on Windows the file is read into a buffer)
+// the view is empty if the file could not be opened
+class MappedFile {
+  const char * data = nullptr;
+  size_t size = 0u;
+  std::string buffer; // only used if the file can not be mapped
+public:
+  explicit MappedFile(const std::string & path);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  std::string_view view() const;
+};
+
+class MeshVertices;
+struct Chunk;
+
+// bytes read at once by WavefrontImporter::parse_batches()
+const size_t WAVEFRONT_BLOCK_SIZE = 1u << 16;
+
 class WavefrontImporter {
   bool counter_clock_wise;
   size_t input_line;
   std::istream & in;
-  Material * current_material;
+  MaterialHandle current_material;
+  float crease_angle;
 
   std::vector< Vertice > vertices;
   std::vector< Normal > normals;
   std::vector< Face > faces;
-  std::map<std::string, Material> materials;
+  IndexedMesh mesh;
+  std::unique_ptr<MeshVertices> mesh_vertices; // the vertex pairs of mesh, created by parse_indexed()
+  Registry<Material> materials;
+  std::vector<std::string> material_libraries;
 
   float parse_float(std::istream & );
   std::vector<float> parse_floats(std::istream & );
@@ -47,16 +105,69 @@ class WavefrontImporter {
   void parse_face();
   void parse_use_material();
   void parse_material_library();
+
+  // fast parser, see parse(std::string_view, unsigned int)
+  void parse_lines(std::string_view text);
+  // parses the parts of text in threads and adds their vertices, normals, and materials in the order of text,
+  //   the faces are left to the caller
+  std::vector<Chunk> parse_chunks(std::string_view text, unsigned int threads);
+  void parse_vertex_data(std::string_view line);
+  void parse_use_material(std::string_view line);
+  void parse_material_library(std::string_view line);
 public:
   WavefrontImporter(std::istream & in);
+
+  // for parse(std::string_view) and parse_file(), there is no input stream
+  WavefrontImporter();
+  ~WavefrontImporter();
   
   // parses the input stream as a char-stream forming a  wavefront file
   // stores the vertices, normals, and faces
   // texture coordinates are ignored
+  // the faces are read like in parse(std::string_view): negative (relative) indices are supported and
+  //   faces with more than three corners are split into triangles (ear clipping)
+  // faces without normals get the normal of their triangle at all three corners
   void parse();
+
+  // parses text like parse() and stores the same vertices, normals, and faces,
+  // but splits the lines with memchr and reads the numbers with std::from_chars
+  //   (no streams, no allocations per line)
+  // every face in get_faces() is a triangle
+  // a line with an invalid number is reported and skipped
+  // threads > 1 splits text at line breaks into parts that are parsed concurrently, the faces are
+  //   created after all vertices, normals, and usemtl lines before them are known;
+  //   0 uses all processor cores, but at least 1 MB per thread
+  void parse(std::string_view text, unsigned int threads = 1);
+
+  // maps the file at path into memory and parses it with parse(std::string_view, unsigned int)
+  void parse_file(const std::string & path, unsigned int threads = 1);
+
+  // parses text like parse(std::string_view) but creates no faces,
+  //   the triangles are stored as an indexed mesh (see get_mesh())
+  // like parse(), repeated calls add to the mesh; a (vertex, normal) pair already in it is reused
+  // faces without normals get smooth normals, see set_crease_angle()
+  // threads as for parse(std::string_view, unsigned int), but only the lines are parsed concurrently:
+  //   the faces are added to the mesh in the calling thread in the order of text, so the mesh does not
+  //   depend on the number of threads
+  void parse_indexed(std::string_view text, unsigned int threads = 1);
+
+  // maps the file at path into memory and parses it with parse_indexed()
+  void parse_file_indexed(const std::string & path, unsigned int threads = 1);
+
+  // parses in like parse(std::string_view) while it is read in blocks of WAVEFRONT_BLOCK_SIZE bytes,
+  //   but stores no faces: consume(batch) is called whenever batch_size triangles are ready
+  //   (the last batch may be smaller), the batch is only valid during the call
+  // only the vertices and normals are kept, because faces may refer to any of them;
+  //   besides them, the memory used is one block and one batch
+  void parse_batches(std::istream & in, size_t batch_size,
+                     const std::function<void(std::span<const BatchTriangle>)> & consume);
+
+  // opens the file at path and parses it with parse_batches()
+  void parse_file_batches(const std::string & path, size_t batch_size,
+                          const std::function<void(std::span<const BatchTriangle>)> & consume);
   
   // parses the input stream as a char-stream froming a wavefront material file
-  // the materials are stored by their name into a map 
+  // the materials are interned by their name, see get_materials()
   // only ambient colors (r,g,b in the value range [0.0, 1.0]) are stored for a material, other information is ignored
   // alpha-values of colors are ignored
   void parse_material(std::istream & in);
@@ -64,12 +175,24 @@ public:
   std::vector< Vertice > & get_vertices();
   std::vector< Normal > & get_normals();
   std::vector< Face > & get_faces();
+  IndexedMesh & get_mesh();
 
+  // for faces without normals in parse_indexed(): the normal at a corner is the area weighted
+  //   average of the normals of the adjacent faces that differ by at most radians from the normal
+  //   of the face, so edges with a larger angle stay sharp (default: 60 degrees)
+  void set_crease_angle(float radians);
+
+  // replaces all materials, they are interned in the order of their names;
+  //   the current material is reset, a face after the call has none until the next usemtl
   void set_materials( std::map<std::string, Material> materials);
   
-  // returns a map containing all materials
-  // a material is stored under its name (as given in the material file) 
-  std::map<std::string, Material> & get_materials();
+  // returns all materials, interned under their names (as given in the material file)
+  // usemtl looks the name up once per line, faces and material ranges refer to the material by
+  //   pointer or handle; the pointers stay valid when further materials are added
+  Registry<Material> & get_materials();
+
+  // returns the paths of all material files given by mtllib, in the order of the file
+  const std::vector<std::string> & get_material_libraries() const;
 
   bool faces_order_is_counter_clock_wise() const;
 };
@@ -0,0 +1,304 @@
+#include "wavefront.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+// Throughput of the WavefrontImporter parsers on synthetic OBJ and MTL files.
+// Every benchmark takes the size of the generated file in KB and a feature mix (see MIXES):
+//   which vertex data is written, which of the f formats is used, comments, usemtl switches.
+// Reported are bytes_per_second and allocs/MB, the calls of operator new per MB of input.
+// To parse other sizes, add Args to the BENCHMARK lines at the end or filter with --benchmark_filter.
+// The *Threads benchmarks take the number of threads as third argument and report the wall time;
+//   their scaling is only meaningful with at least as many cores (counter "cores").
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+// the kinds of lines in a generated OBJ file
+struct ObjMix {
+  const char * name;
+  bool texture_coordinates; // vt lines, faces v/vt or v/vt/vn
+  bool normals;             // vn lines, faces v//vn or v/vt/vn
+  bool comments;            // a comment line after each block and a comment at the end of some faces
+  bool materials;           // usemtl switches between MATERIAL_COUNT materials
+};
+
+const ObjMix MIXES[] = {
+  {"f v",                          false, false, false, false},
+  {"f v/vt",                       true,  false, false, false},
+  {"f v//vn",                      false, true,  false, false},
+  {"f v/vt/vn, comments, usemtl",  true,  true,  true,  true },
+};
+
+const size_t BLOCK_VERTICES = 64;  // vertices (and normals, texture coordinates) per block
+const size_t BLOCK_FACES = 128;    // faces per block, between the vertices of the block
+const size_t MATERIAL_COUNT = 8;
+
+void append_float(std::string & out, float number) {
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number, std::chars_format::fixed, 6);
+  out.append(buffer, result.ptr);
+}
+
+void append_floats(std::string & out, const char * keyword, std::mt19937 & generator, size_t count) {
+  std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+  out += keyword;
+  for (size_t i = 0; i < count; i++) {
+    out += ' ';
+    append_float(out, distribution(generator));
+  }
+  out += '\n';
+}
+
+// an OBJ file of at least size bytes, from blocks of vertex data followed by faces over them
+std::string generate_obj(size_t size, const ObjMix & mix) {
+  std::mt19937 generator(42u);
+  std::uniform_int_distribution<size_t> corner(0, BLOCK_VERTICES - 1);
+  std::string out;
+  out.reserve(size + 16 * 1024);
+  size_t vertices = 0;
+  for (size_t block = 0; out.size() < size; block++) {
+    if (mix.comments) {
+      out += "# block " + std::to_string(block) + "\n";
+    }
+    for (size_t i = 0; i < BLOCK_VERTICES; i++) {
+      append_floats(out, "v", generator, 3);
+      if (mix.texture_coordinates) {
+        append_floats(out, "vt", generator, 2);
+      }
+      if (mix.normals) {
+        append_floats(out, "vn", generator, 3);
+      }
+    }
+    vertices += BLOCK_VERTICES;
+    if (mix.materials) {
+      out += "usemtl m" + std::to_string(block % MATERIAL_COUNT) + "\n";
+    }
+    for (size_t face = 0; face < BLOCK_FACES; face++) {
+      out += 'f';
+      for (size_t i = 0; i < 3; i++) {
+        const std::string index = std::to_string(vertices - BLOCK_VERTICES + corner(generator) + 1);
+        out += ' ';
+        out += index;
+        if (mix.texture_coordinates) {
+          out += '/';
+          out += index;
+        }
+        if (mix.normals) {
+          out += mix.texture_coordinates ? "/" : "//";
+          out += index;
+        }
+      }
+      if (mix.comments && face % 16 == 0) {
+        out += " # face";
+      }
+      out += '\n';
+    }
+  }
+  return out;
+}
+
+// an MTL file of at least size bytes, with the materials m0, m1, ... as written by Blender
+std::string generate_mtl(size_t size) {
+  std::mt19937 generator(7u);
+  std::string out;
+  for (size_t material = 0; out.size() < size; material++) {
+    out += "# material\nnewmtl m" + std::to_string(material) + "\n";
+    append_floats(out, "Ns", generator, 1);
+    append_floats(out, "Ka", generator, 3);
+    append_floats(out, "Kd", generator, 3);
+    append_floats(out, "Ks", generator, 3);
+    out += "Ni 1.450000\nd 1.000000\nillum 2\n\n";
+  }
+  return out;
+}
+
+std::map<std::string, Material> generated_materials() {
+  std::map<std::string, Material> materials;
+  for (size_t i = 0; i < MATERIAL_COUNT; i++) {
+    materials["m" + std::to_string(i)] = {{1.0f, 0.5f, 0.25f}};
+  }
+  return materials;
+}
+
+// an input stream over a string without copying it
+class StringViewBuffer : public std::streambuf {
+public:
+  explicit StringViewBuffer(std::string_view text) {
+    char * begin = const_cast<char *>(text.data());
+    setg(begin, begin, begin + text.size());
+  }
+};
+
+const std::string & obj_text(const benchmark::State & state) {
+  static std::map<std::pair<int64_t, int64_t>, std::string> texts;
+  std::string & text = texts[{state.range(0), state.range(1)}];
+  if (text.empty()) {
+    text = generate_obj(static_cast<size_t>(state.range(0)) * 1024u, MIXES[state.range(1)]);
+  }
+  return text;
+}
+
+// bytes_per_second and allocs/MB for size bytes per iteration
+void set_counters(benchmark::State & state, size_t size, size_t allocated) {
+  const double megabytes = static_cast<double>(state.iterations()) * static_cast<double>(size) / 1e6;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+  state.counters["allocs/MB"] = static_cast<double>(allocated) / megabytes;
+  state.SetLabel(MIXES[state.range(1)].name);
+}
+
+// the parser of the input stream
+void BM_ParseStream(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    StringViewBuffer buffer(text);
+    std::istream in(&buffer);
+    WavefrontImporter importer(in);
+    importer.set_materials(materials);
+    importer.parse();
+    benchmark::DoNotOptimize(importer.get_faces().data());
+  }
+  set_counters(state, text.size(), allocations - allocated);
+}
+
+void BM_ParseStringView(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    WavefrontImporter importer;
+    importer.set_materials(materials);
+    importer.parse(std::string_view(text));
+    benchmark::DoNotOptimize(importer.get_faces().data());
+  }
+  set_counters(state, text.size(), allocations - allocated);
+}
+
+void BM_ParseIndexed(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    WavefrontImporter importer;
+    importer.set_materials(materials);
+    importer.parse_indexed(text);
+    benchmark::DoNotOptimize(importer.get_mesh().indices.data());
+  }
+  set_counters(state, text.size(), allocations - allocated);
+}
+
+// parse(std::string_view, threads) with state.range(2) threads
+void BM_ParseThreads(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    WavefrontImporter importer;
+    importer.set_materials(materials);
+    importer.parse(std::string_view(text), static_cast<unsigned int>(state.range(2)));
+    benchmark::DoNotOptimize(importer.get_faces().data());
+  }
+  set_counters(state, text.size(), allocations - allocated);
+  state.counters["cores"] = std::thread::hardware_concurrency();
+}
+
+// parse_indexed(text, threads) with state.range(2) threads
+void BM_ParseIndexedThreads(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    WavefrontImporter importer;
+    importer.set_materials(materials);
+    importer.parse_indexed(text, static_cast<unsigned int>(state.range(2)));
+    benchmark::DoNotOptimize(importer.get_mesh().indices.data());
+  }
+  set_counters(state, text.size(), allocations - allocated);
+  state.counters["cores"] = std::thread::hardware_concurrency();
+}
+
+void BM_ParseBatches(benchmark::State & state) {
+  const std::string & text = obj_text(state);
+  const std::map<std::string, Material> materials = generated_materials();
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    StringViewBuffer buffer(text);
+    std::istream in(&buffer);
+    WavefrontImporter importer;
+    importer.set_materials(materials);
+    size_t triangles = 0;
+    importer.parse_batches(in, 4096, [&triangles](std::span<const BatchTriangle> batch) { triangles += batch.size(); });
+    benchmark::DoNotOptimize(triangles);
+  }
+  set_counters(state, text.size(), allocations - allocated);
+}
+
+void BM_ParseMaterial(benchmark::State & state) {
+  const std::string text = generate_mtl(static_cast<size_t>(state.range(0)) * 1024u);
+  const size_t allocated = allocations;
+  for (auto _ : state) {
+    StringViewBuffer buffer(text);
+    std::istream in(&buffer);
+    WavefrontImporter importer;
+    importer.parse_material(in);
+    benchmark::DoNotOptimize(importer.get_materials().size());
+  }
+  const double megabytes = static_cast<double>(state.iterations()) * static_cast<double>(text.size()) / 1e6;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+  state.counters["allocs/MB"] = static_cast<double>(allocations - allocated) / megabytes;
+}
+
+// 64 KB and 4 MB for every mix
+void obj_arguments(benchmark::internal::Benchmark * benchmark) {
+  for (int64_t kilobytes : {64, 4096}) {
+    for (int64_t mix = 0; mix < static_cast<int64_t>(std::size(MIXES)); mix++) {
+      benchmark->Args({kilobytes, mix});
+    }
+  }
+  benchmark->ArgNames({"KB", "mix"})->Unit(benchmark::kMillisecond);
+}
+
+// 16 MB with normals, comments and usemtl, for 1 to 8 threads
+void thread_arguments(benchmark::internal::Benchmark * benchmark) {
+  for (int64_t threads : {1, 2, 4, 8}) {
+    benchmark->Args({16384, 3, threads});
+  }
+  benchmark->ArgNames({"KB", "mix", "threads"})->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}
+
+// counts all allocations of the program, the benchmarks use the difference over their loop
+// (not inlined, gcc would report the free() of memory from operator new)
+[[gnu::noinline]] void * operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void * memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void * memory) noexcept {
+  std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void * memory, size_t) noexcept {
+  std::free(memory);
+}
+
+BENCHMARK(BM_ParseStream)->Apply(obj_arguments);
+BENCHMARK(BM_ParseStringView)->Apply(obj_arguments);
+BENCHMARK(BM_ParseIndexed)->Apply(obj_arguments);
+BENCHMARK(BM_ParseThreads)->Apply(thread_arguments);
+BENCHMARK(BM_ParseIndexedThreads)->Apply(thread_arguments);
+BENCHMARK(BM_ParseBatches)->Apply(obj_arguments);
+BENCHMARK(BM_ParseMaterial)->Arg(64)->Arg(1024)->ArgName("KB")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,112 @@
+#include "wavefront.h"
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+// libFuzzer target for the WavefrontImporter parsers (built with clang, see CMakeLists.txt):
+//   the input is parsed as OBJ file by every parser and as MTL file by parse_material()
+// Invalid indices may throw std::out_of_range, too many vertices std::length_error;
+//   everything else (crashes, sanitizer reports, other exceptions) is a bug.
+// If the input is parsed without an exception, the fast parsers must agree on the triangles.
+// Without libFuzzer (WAVEFRONT_FUZZER_MAIN), main() runs the target once for each file given,
+//   e.g. for a corpus or crash files found before.
+
+namespace {
+
+void check(bool condition) {
+  if (!condition) {
+    std::abort();
+  }
+}
+
+// the number of triangles, or SIZE_MAX if the input has an invalid index
+template <class PARSE>
+size_t triangles(PARSE parse) {
+  try {
+    return parse();
+  } catch (const std::out_of_range &) {
+    return SIZE_MAX;
+  } catch (const std::length_error &) {
+    return SIZE_MAX;
+  }
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size) {
+  const std::string_view text(reinterpret_cast<const char *>(data), size);
+  // mtllib opens the file named in the input
+  if (text.find("mtllib") != std::string_view::npos) {
+    return -1;
+  }
+
+  triangles([&text]() {
+    std::istringstream in{std::string(text)};
+    WavefrontImporter importer(in);
+    importer.parse();
+    return importer.get_faces().size();
+  });
+
+  const size_t sequential = triangles([&text]() {
+    WavefrontImporter importer;
+    importer.parse(text);
+    return importer.get_faces().size();
+  });
+  const size_t parallel = triangles([&text]() {
+    WavefrontImporter importer;
+    importer.parse(text, 3);
+    return importer.get_faces().size();
+  });
+  const size_t indexed = triangles([&text]() {
+    WavefrontImporter importer;
+    importer.parse_indexed(text);
+    for (uint32_t index : importer.get_mesh().indices) {
+      check(index < importer.get_mesh().positions.size());
+    }
+    return importer.get_mesh().indices.size() / 3;
+  });
+  const size_t indexed_parallel = triangles([&text]() {
+    WavefrontImporter importer;
+    importer.parse_indexed(text, 3);
+    for (uint32_t index : importer.get_mesh().indices) {
+      check(index < importer.get_mesh().positions.size());
+    }
+    return importer.get_mesh().indices.size() / 3;
+  });
+  const size_t batches = triangles([&text]() {
+    std::istringstream in{std::string(text)};
+    WavefrontImporter importer;
+    size_t count = 0;
+    importer.parse_batches(in, 7, [&count](std::span<const BatchTriangle> batch) {
+      check(!batch.empty() && batch.size() <= 7);
+      count += batch.size();
+    });
+    return count;
+  });
+  if (sequential != SIZE_MAX) {
+    check(parallel == sequential && indexed == sequential && indexed_parallel == sequential && batches == sequential);
+  }
+
+  std::istringstream in{std::string(text)};
+  WavefrontImporter importer;
+  importer.parse_material(in);
+  return 0;
+}
+
+#ifdef WAVEFRONT_FUZZER_MAIN
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+int main(int argc, char ** argv) {
+  for (int i = 1; i < argc; i++) {
+    std::ifstream file(argv[i], std::ios::binary);
+    const std::string input{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+  }
+  std::cout << "ran " << argc - 1 << " inputs" << std::endl;
+  return 0;
+}
+#endif
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <numbers>
 
 #include "gtest/gtest.h"
 
@@ -297,10 +298,10 @@ std::stringstream ss( "newmtl red\n"
                       "Kd 1.000 1.000 0.000\n" );  
   WavefrontImporter importer(ss);               
   importer.parse_material(ss);                                       
-  std::map<std::string, Material> materials = importer.get_materials();
+  Registry<Material> materials = importer.get_materials();
   
   ASSERT_EQ(6, materials.size());
-  Color color = materials["cyan"].ambient;
+  Color color = materials.at("cyan").ambient;
   ASSERT_NEAR(0.0f, color[0], 0.00001f);
   ASSERT_NEAR(1.0f, color[1], 0.00001f);
   ASSERT_NEAR(1.0f, color[2], 0.00001f);
@@ -310,11 +311,11 @@ TEST(WAVEFRONT_IMPORTER, ParseMaterialFromFile) {
   std::fstream fs("basic.mtl");  
   WavefrontImporter importer(fs);               
   importer.parse_material(fs);                                       
-  std::map<std::string, Material> 
+  Registry<Material> 
   materials = importer.get_materials();
   
   ASSERT_EQ(6, materials.size());
-  Color color = materials["red"].ambient;
+  Color color = materials.at("red").ambient;
   ASSERT_NEAR(1.0f, color[0], 0.00001f);
   ASSERT_NEAR(0.0f, color[1], 0.00001f);
   ASSERT_NEAR(0.0f, color[2], 0.00001f);
@@ -366,19 +367,394 @@ std::stringstream ss( "mtllib basic.mtl\n"
   ASSERT_NEAR(1.0f, color[2], 0.00001f);
 }
 
+// the fast parser (string_view, from_chars) must give exactly the same results as the stream parser
+void expect_same_result(WavefrontImporter & expected, WavefrontImporter & actual) {
+  ASSERT_EQ(expected.get_vertices(), actual.get_vertices());
+  ASSERT_EQ(expected.get_normals(), actual.get_normals());
+  ASSERT_EQ(expected.get_faces().size(), actual.get_faces().size());
+  for (size_t i = 0; i < expected.get_faces().size(); i++) {
+    const Face & expected_face = expected.get_faces()[i];
+    const Face & actual_face = actual.get_faces()[i];
+    ASSERT_EQ(expected_face.reference_groups.size(), actual_face.reference_groups.size());
+    for (size_t j = 0; j < expected_face.reference_groups.size(); j++) {
+      ASSERT_EQ(expected_face.reference_groups[j].vertice, actual_face.reference_groups[j].vertice);
+      ASSERT_EQ(expected_face.reference_groups[j].normal, actual_face.reference_groups[j].normal);
+    }
+    ASSERT_EQ(expected_face.material == nullptr, actual_face.material == nullptr);
+    if (expected_face.material != nullptr) {
+      ASSERT_EQ(expected_face.material->ambient, actual_face.material->ambient);
+    }
+  }
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseStringViewLikeStream) {
+  std::string text = "# comment\n"
+                     "mtllib basic.mtl\n"
+                     "v 1.0 2.0 -0.4\n"
+                     "v  +0.5\t-1e-3 3.25e2\r\n"
+                     "\n"
+                     "v -1 -1 -1\n"
+                     "vt 0.5 0.5\n"
+                     "vn 0.0 1.0 0.0\n"
+                     "vn 1.0 0.0 0.0\n"
+                     "usemtl red\n"
+                     "f 1//1 2//1 3//2\n"
+                     "f 1/1/2 2/1/2 3/1/1\n"
+                     "usemtl blue\r\n"
+                     "f 3 2 1\n"
+                     "f 1 2 3 # comment";
+  std::stringstream ss(text);
+  WavefrontImporter expected(ss);
+  expected.parse();
+  WavefrontImporter actual;
+  actual.parse(std::string_view(text));
+
+  ASSERT_EQ(3, actual.get_vertices().size());
+  ASSERT_EQ(4, actual.get_faces().size());
+  expect_same_result(expected, actual);
+  ASSERT_EQ(0.0f, actual.get_faces()[2].material->ambient[0]); // blue
+}
+
+// the stream parser keeps all corners of a polygon, faces without normals get the normal of their triangle
+TEST(WAVEFRONT_IMPORTER, ParseStreamPolygons) {
+  const std::string text = "v 0 0 0\nv 2 0 0\nv 2 1 0\nv 0 1 0\nv 0 0 3\nvn 0 0 1\n"
+                           "f 1//1 2//1 3//1 4//1\nf 1 2 -1\n";
+  std::stringstream ss(text);
+  WavefrontImporter expected(ss);
+  expected.parse();
+  WavefrontImporter actual;
+  actual.parse(std::string_view(text));
+  ASSERT_EQ(3, expected.get_faces().size());
+  expect_same_result(expected, actual);
+
+  const Face & unshaded = expected.get_faces()[2];
+  for (const ReferenceGroup & group : unshaded.reference_groups) {
+    ASSERT_EQ((Normal{0.0f, -1.0f, 0.0f}), group.normal);
+  }
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseNegativeIndices) {
+  WavefrontImporter importer;
+  importer.parse(std::string_view("v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nf -3//-1 -2//-1 -1//-1\n"));
+  ASSERT_EQ(1, importer.get_faces().size());
+  const Face & face = importer.get_faces()[0];
+  ASSERT_EQ(importer.get_vertices()[0], face.reference_groups[0].vertice);
+  ASSERT_EQ(importer.get_vertices()[2], face.reference_groups[2].vertice);
+  ASSERT_EQ(importer.get_normals()[0], face.reference_groups[1].normal);
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseFileLikeStream) {
+  for (const std::string file : {"teapot.obj", "space_ship.obj", "asteroid.obj", "torpedo.obj", "ufo.obj"}) {
+    std::fstream fs(file);
+    WavefrontImporter expected(fs);
+    expected.parse();
+    WavefrontImporter actual;
+    actual.parse_file(file);
+
+    ASSERT_LT(0, actual.get_faces().size()) << file;
+    expect_same_result(expected, actual);
+  }
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseParallelLikeSequential) {
+  for (const std::string file : {"teapot.obj", "space_ship.obj", "ufo.obj"}) {
+    WavefrontImporter expected;
+    expected.parse_file(file);
+    for (unsigned int threads : {2u, 3u, 8u}) {
+      WavefrontImporter actual;
+      actual.parse_file(file, threads);
+      expect_same_result(expected, actual);
+    }
+  }
+}
+
+// the triangles of the indexed mesh are the faces of parse()
+TEST(WAVEFRONT_IMPORTER, ParseIndexedLikeFaces) {
+  for (const std::string file : {"teapot.obj", "space_ship.obj", "asteroid.obj", "torpedo.obj", "ufo.obj"}) {
+    WavefrontImporter expected;
+    expected.parse_file(file);
+    WavefrontImporter actual;
+    actual.parse_file_indexed(file);
+
+    const std::vector<Face> & faces = expected.get_faces();
+    const IndexedMesh & mesh = actual.get_mesh();
+    ASSERT_EQ(0, actual.get_faces().size());
+    ASSERT_EQ(3 * faces.size(), mesh.indices.size()) << file;
+    ASSERT_EQ(mesh.positions.size(), mesh.normals.size());
+    ASSERT_GE(faces.size() * 3, mesh.positions.size()) << file;
+    size_t range = 0;
+    for (size_t i = 0; i < faces.size(); i++) {
+      for (size_t j = 0; j < 3; j++) {
+        const uint32_t index = mesh.indices[3 * i + j];
+        ASSERT_EQ(faces[i].reference_groups[j].vertice, mesh.positions.at(index));
+        ASSERT_EQ(faces[i].reference_groups[j].normal, mesh.normals.at(index));
+      }
+      if (3 * i == mesh.material_ranges[range].first + mesh.material_ranges[range].count) {
+        range++;
+      }
+      ASSERT_LE(mesh.material_ranges[range].first, 3 * i);
+      ASSERT_EQ(faces[i].material == nullptr, !mesh.material_ranges[range].material.is_valid());
+      if (faces[i].material != nullptr) {
+        ASSERT_EQ(faces[i].material->ambient, actual.get_materials()[mesh.material_ranges[range].material].ambient);
+      }
+    }
+    ASSERT_EQ(mesh.material_ranges.size(), range + 1);
+    ASSERT_EQ(mesh.indices.size(), mesh.material_ranges.back().first + mesh.material_ranges.back().count);
+  }
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseIndexedSharesVertices) {
+  WavefrontImporter importer;
+  importer.set_materials({{"red", {{1.0f, 0.0f, 0.0f}}}});
+  // a square of two triangles and a third triangle with the same positions, but another normal
+  importer.parse_indexed("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\nvn 0 0 -1\n"
+                         "f 1//1 2//1 3//1\nf 1//1 3//1 4//1\nusemtl red\nf 1//2 3//2 4//2\n");
+  const IndexedMesh & mesh = importer.get_mesh();
+  ASSERT_EQ(7, mesh.positions.size());
+  ASSERT_EQ((std::vector<uint32_t>{0, 1, 2, 0, 2, 3, 4, 5, 6}), mesh.indices);
+  ASSERT_EQ(importer.get_normals()[1], mesh.normals[4]);
+  ASSERT_EQ(2, mesh.material_ranges.size());
+  ASSERT_FALSE(mesh.material_ranges[0].material.is_valid());
+  ASSERT_EQ(6, mesh.material_ranges[0].count);
+  ASSERT_TRUE(importer.get_materials().find("red") == mesh.material_ranges[1].material);
+  ASSERT_EQ(6, mesh.material_ranges[1].first);
+  ASSERT_EQ(3, mesh.material_ranges[1].count);
+}
+
+// a handle of the replaced materials is not used for the following faces
+TEST(WAVEFRONT_IMPORTER, SetMaterialsResetsCurrentMaterial) {
+  WavefrontImporter importer;
+  importer.set_materials({{"blue", {{0.0f, 0.0f, 1.0f}}}, {"red", {{1.0f, 0.0f, 0.0f}}}});
+  importer.parse_indexed("v 0 0 0\nv 1 0 0\nv 1 1 0\nusemtl red\nf 1 2 3\n");
+  importer.set_materials({{"green", {{0.0f, 1.0f, 0.0f}}}});
+  importer.parse_indexed("f 1 2 3\n");
+  const IndexedMesh & mesh = importer.get_mesh();
+  ASSERT_EQ(2, mesh.material_ranges.size());
+  ASSERT_FALSE(mesh.material_ranges[1].material.is_valid());
+  ASSERT_EQ(nullptr, importer.get_materials().get(mesh.material_ranges[1].material));
+}
+
+// a second call adds to the mesh of the first, like parse() adds faces
+TEST(WAVEFRONT_IMPORTER, ParseIndexedTwice) {
+  const std::string first = "v 0 0 0\nv 1 0 0\nv 1 1 0\nvn 0 0 1\nf 1//1 2//1 3//1\n";
+  const std::string second = "v 0 1 0\nf 1//1 3//1 4//1\nf 1//1 2//1 3//1\nf 1 3 4\n";
+  WavefrontImporter once;
+  once.parse_indexed(first + second);
+  WavefrontImporter twice;
+  twice.parse_indexed(first);
+  twice.parse_indexed(second);
+  ASSERT_EQ(once.get_mesh().positions, twice.get_mesh().positions);
+  ASSERT_EQ(once.get_mesh().normals, twice.get_mesh().normals);
+  ASSERT_EQ(once.get_mesh().indices, twice.get_mesh().indices);
+  ASSERT_EQ((std::vector<uint32_t>{0, 1, 2, 0, 2, 3, 0, 1, 2, 4, 5, 6}), twice.get_mesh().indices);
+}
+
+// faces with more than three corners become triangles of the same orientation and total area
+TEST(WAVEFRONT_IMPORTER, ParsePolygons) {
+  // a convex quad, and a concave pentagon with the reflex corner 8
+  const std::string text = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                           "v 0 0 1\nv 2 0 1\nv 2 2 1\nv 1 1 1\nv 0 2 1\n"
+                           "f 1 2 3 4\nf 5 6 7 8 9 # comment\n";
+  WavefrontImporter importer;
+  importer.parse(text);
+  const std::vector<Face> & faces = importer.get_faces();
+  ASSERT_EQ(5, faces.size());
+  // a fan for the convex quad
+  ASSERT_EQ((Vertice{0.0f, 0.0f, 0.0f}), faces[0].reference_groups[0].vertice);
+  ASSERT_EQ((Vertice{1.0f, 0.0f, 0.0f}), faces[0].reference_groups[1].vertice);
+  ASSERT_EQ((Vertice{1.0f, 1.0f, 0.0f}), faces[0].reference_groups[2].vertice);
+  ASSERT_EQ((Vertice{0.0f, 0.0f, 0.0f}), faces[1].reference_groups[0].vertice);
+  ASSERT_EQ((Vertice{1.0f, 1.0f, 0.0f}), faces[1].reference_groups[1].vertice);
+  ASSERT_EQ((Vertice{0.0f, 1.0f, 0.0f}), faces[1].reference_groups[2].vertice);
+  float area = 0.0f;
+  for (size_t i = 2; i < faces.size(); i++) {
+    ASSERT_EQ(3, faces[i].reference_groups.size());
+    const Vertice & a = faces[i].reference_groups[0].vertice;
+    const Vertice & b = faces[i].reference_groups[1].vertice;
+    const Vertice & c = faces[i].reference_groups[2].vertice;
+    const float doubled = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    ASSERT_LT(0.0f, doubled);
+    area += doubled / 2.0f;
+  }
+  ASSERT_FLOAT_EQ(3.0f, area);
+
+  WavefrontImporter parallel;
+  parallel.parse(text, 3);
+  ASSERT_EQ(faces.size(), parallel.get_faces().size());
+  for (size_t i = 0; i < faces.size(); i++) {
+    for (size_t j = 0; j < 3; j++) {
+      ASSERT_EQ(faces[i].reference_groups[j].vertice, parallel.get_faces()[i].reference_groups[j].vertice);
+    }
+  }
+
+  WavefrontImporter indexed;
+  indexed.parse_indexed(text);
+  ASSERT_EQ(3 * faces.size(), indexed.get_mesh().indices.size());
+  ASSERT_EQ(3 * faces.size(), indexed.get_mesh().material_ranges[0].count);
+}
+
+// a cube of quads without normals: flat sides with the default crease angle, smooth corners with 180 degrees
+TEST(WAVEFRONT_IMPORTER, ParseIndexedCalculatesNormals) {
+  const std::string cube = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\n"
+                           "f 1 4 3 2\nf 5 6 7 8\nf 1 2 6 5\nf 3 4 8 7\nf 1 5 8 4\nf 2 3 7 6\n";
+  WavefrontImporter flat;
+  flat.parse_indexed(cube);
+  const IndexedMesh & sides = flat.get_mesh();
+  ASSERT_EQ(24, sides.positions.size());
+  ASSERT_EQ(36, sides.indices.size());
+  for (size_t i = 0; i < sides.indices.size(); i += 3) {
+    const Vertice & a = sides.positions[sides.indices[i]];
+    const Vertice & b = sides.positions[sides.indices[i + 1]];
+    const Vertice & c = sides.positions[sides.indices[i + 2]];
+    const Normal expected = {(b[1] - a[1]) * (c[2] - a[2]) - (b[2] - a[2]) * (c[1] - a[1]),
+                             (b[2] - a[2]) * (c[0] - a[0]) - (b[0] - a[0]) * (c[2] - a[2]),
+                             (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])};
+    for (size_t j = 0; j < 3; j++) {
+      ASSERT_EQ(expected, sides.normals[sides.indices[i + j]]);
+    }
+  }
+
+  WavefrontImporter smooth;
+  smooth.set_crease_angle(std::numbers::pi_v<float>);
+  smooth.parse_indexed(cube);
+  const IndexedMesh & corners = smooth.get_mesh();
+  ASSERT_EQ(8, corners.positions.size());
+  for (size_t i = 0; i < corners.positions.size(); i++) {
+    const Normal & normal = corners.normals[i];
+    ASSERT_NEAR(1.0f, normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2], 1e-5f);
+    for (size_t axis = 0; axis < 3; axis++) {
+      // pointing away from the center
+      ASSERT_LT(0.0f, (corners.positions[i][axis] - 0.5f) * normal[axis]);
+    }
+  }
+}
+
+// with many threads almost every line is a chunk of its own: relative indices and usemtl refer to previous chunks
+TEST(WAVEFRONT_IMPORTER, ParseParallelAcrossChunks) {
+  const std::string_view text = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nusemtl red\n"
+                                "f -3//-1 -2//-1 -1//-1\nv 1 1 0\nf 2//1 4//1 -1//-1\n"
+                                "usemtl blue\nvn 0 0 -1\nf 1//2 -2//-1 -3//-2\nf 1 2 3\n";
+  const std::map<std::string, Material> materials = {{"red", {{1.0f, 0.0f, 0.0f}}}, {"blue", {{0.0f, 0.0f, 1.0f}}}};
+  WavefrontImporter expected;
+  expected.set_materials(materials);
+  expected.parse(text);
+  ASSERT_EQ(4, expected.get_faces().size());
+  for (unsigned int threads : {2u, 5u, 64u}) {
+    WavefrontImporter actual;
+    actual.set_materials(materials);
+    actual.parse(text, threads);
+    expect_same_result(expected, actual);
+  }
+
+  // an index of a vertex after the face
+  WavefrontImporter importer;
+  ASSERT_THROW(importer.parse(std::string_view("v 0 0 0\nf 1 2 1\nv 1 0 0\n"), 3), std::out_of_range);
+
+  // no chunk at all
+  importer.parse(std::string_view(), 3);
+  ASSERT_EQ(0, importer.get_faces().size());
+}
+
+// the indexed mesh does not depend on the number of threads, not even across chunks
+TEST(WAVEFRONT_IMPORTER, ParseIndexedParallelLikeSequential) {
+  const std::string across_chunks = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nusemtl red\n"
+                                    "f -3//-1 -2//-1 -1//-1\nv 1 1 0\nf 2//1 4//1 -1//-1\n"
+                                    "usemtl blue\nvn 0 0 -1\nf 1//2 -2//-1 -3//-2\nf 1 2 3\nf 1 2 4 3\n";
+  const std::map<std::string, Material> materials = {{"red", {{1.0f, 0.0f, 0.0f}}}, {"blue", {{0.0f, 0.0f, 1.0f}}}};
+  std::stringstream text;
+  text << std::ifstream("teapot.obj").rdbuf() << across_chunks;
+  for (const std::string & input : {across_chunks, text.str()}) {
+    WavefrontImporter expected;
+    expected.set_materials(materials);
+    expected.parse_indexed(input);
+    for (unsigned int threads : {2u, 3u, 64u}) {
+      WavefrontImporter actual;
+      actual.set_materials(materials);
+      actual.parse_indexed(input, threads);
+      ASSERT_EQ(expected.get_vertices(), actual.get_vertices());
+      ASSERT_EQ(expected.get_mesh().positions, actual.get_mesh().positions);
+      ASSERT_EQ(expected.get_mesh().normals, actual.get_mesh().normals);
+      ASSERT_EQ(expected.get_mesh().indices, actual.get_mesh().indices);
+      ASSERT_EQ(expected.get_mesh().material_ranges.size(), actual.get_mesh().material_ranges.size());
+      for (size_t i = 0; i < expected.get_mesh().material_ranges.size(); i++) {
+        const IndexedMesh::MaterialRange & range = expected.get_mesh().material_ranges[i];
+        ASSERT_TRUE(range.material == actual.get_mesh().material_ranges[i].material);
+        ASSERT_EQ(range.first, actual.get_mesh().material_ranges[i].first);
+        ASSERT_EQ(range.count, actual.get_mesh().material_ranges[i].count);
+      }
+    }
+  }
+
+  WavefrontImporter importer;
+  ASSERT_THROW(importer.parse_indexed(std::string_view("v 0 0 0\nf 1 2 1\nv 1 0 0\n"), 3), std::out_of_range);
+}
+
+// the faces of all batches, collected to compare them with parse()
+void expect_batches_like_faces(WavefrontImporter & expected, WavefrontImporter & actual,
+                               const std::vector<BatchTriangle> & triangles) {
+  ASSERT_EQ(expected.get_vertices(), actual.get_vertices());
+  ASSERT_EQ(expected.get_normals(), actual.get_normals());
+  ASSERT_EQ(0, actual.get_faces().size());
+  ASSERT_EQ(expected.get_faces().size(), triangles.size());
+  for (size_t i = 0; i < triangles.size(); i++) {
+    const Face & face = expected.get_faces()[i];
+    for (size_t j = 0; j < 3; j++) {
+      ASSERT_EQ(face.reference_groups[j].vertice, triangles[i].corners[j].vertice);
+      ASSERT_EQ(face.reference_groups[j].normal, triangles[i].corners[j].normal);
+    }
+    ASSERT_EQ(face.material == nullptr, triangles[i].material == nullptr);
+  }
+}
+
+TEST(WAVEFRONT_IMPORTER, ParseBatchesLikeParse) {
+  for (const std::string file : {"teapot.obj", "space_ship.obj", "ufo.obj"}) {
+    WavefrontImporter expected;
+    expected.parse_file(file);
+    WavefrontImporter actual;
+    std::vector<BatchTriangle> triangles;
+    size_t batches = 0;
+    actual.parse_file_batches(file, 100, [&](std::span<const BatchTriangle> batch) {
+      ASSERT_TRUE(batch.size() == 100 || triangles.size() + batch.size() == expected.get_faces().size());
+      triangles.insert(triangles.end(), batch.begin(), batch.end());
+      batches++;
+    });
+    ASSERT_EQ((expected.get_faces().size() + 99) / 100, batches) << file;
+    expect_batches_like_faces(expected, actual, triangles);
+  }
+}
+
+// lines across blocks, a line longer than a block, and no line break at the end
+TEST(WAVEFRONT_IMPORTER, ParseBatchesAcrossBlocks) {
+  std::string text = "# " + std::string(2 * WAVEFRONT_BLOCK_SIZE, '-') + "\n";
+  for (int i = 0; text.size() < 3 * WAVEFRONT_BLOCK_SIZE; i++) {
+    text += "v " + std::to_string(i) + " 0.5 -1\nv 1 " + std::to_string(i) + " 0\nv 0 0 " + std::to_string(i) + "\n";
+    text += "vn 0 0 1\nf -3//-1 -2//-1 -1//-1 -3//-1\n";
+  }
+  text += "f 1 2 3";
+  WavefrontImporter expected;
+  expected.parse(std::string_view(text));
+  WavefrontImporter actual;
+  std::vector<BatchTriangle> triangles;
+  std::stringstream ss(text);
+  actual.parse_batches(ss, 1000, [&](std::span<const BatchTriangle> batch) {
+    triangles.insert(triangles.end(), batch.begin(), batch.end());
+  });
+  expect_batches_like_faces(expected, actual, triangles);
+}
+
 /*
 // cube.obj has to be in the same folder like the test executable!
 TEST(WAVEFRONT_IMPORTER, ParseFromFile) {
   std::fstream fs( "cube.obj" );  
   WavefrontImporter importer(fs);               
   importer.parse();                                       
-  std::map<std::string, Material> materials = importer.get_materials();
+  Registry<Material> materials = importer.get_materials();
   
   ASSERT_EQ(8, importer.get_vertices().size());  
   ASSERT_EQ(6, importer.get_normals().size());  
   ASSERT_EQ(12, importer.get_faces().size());  
   ASSERT_EQ(6, materials.size());
-  Color color = materials["cyan"].ambient;
+  Color color = materials.at("cyan").ambient;
   ASSERT_NEAR(0.0f, color[0], 0.00001f);
   ASSERT_NEAR(1.0f, color[1], 0.00001f);
   ASSERT_NEAR(1.0f, color[2], 0.00001f);
@@ -0,0 +1,66 @@
+#include "asset_loader.h"
+#include <algorithm>
+#include <stdexcept>
+#include "debug.h"
+
+AssetLoader::AssetLoader(unsigned int threads) {
+  if (threads == 0) {
+    threads = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+  }
+  for (unsigned int i = 0; i < threads; i++) {
+    workers.emplace_back([this]() { work(); });
+  }
+}
+
+AssetLoader::~AssetLoader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    pending.clear();
+  }
+  requested.notify_all();
+  workers.clear(); // jthread wartet im Destruktor auf das Ende des Workers
+}
+
+void AssetLoader::load(const std::string & path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(path);
+  }
+  requested.notify_one();
+}
+
+std::vector<LoadedMesh> AssetLoader::take_loaded() {
+  std::vector<LoadedMesh> result;
+  std::lock_guard<std::mutex> lock(mutex);
+  result.swap(loaded);
+  return result;
+}
+
+bool AssetLoader::is_idle() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return pending.empty() && loading == 0 && loaded.empty();
+}
+
+void AssetLoader::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    requested.wait(lock, [this]() { return stopping || !pending.empty(); });
+    if (stopping) {
+      return;
+    }
+    LoadedMesh result{pending.front(), nullptr};
+    pending.pop_front();
+    loading++;
+    // parsen und mappen ohne Sperre, die anderen Worker und der GL-Thread laufen weiter
+    lock.unlock();
+    try {
+      result.mesh = std::make_unique<CachedMesh>(result.path);
+    } catch (const std::exception & exception) {
+      warning("could not load " + result.path + ": " + exception.what());
+    }
+    lock.lock();
+    loading--;
+    loaded.push_back(std::move(result));
+  }
+}
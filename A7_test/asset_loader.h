@@ -0,0 +1,52 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+// Laedt die Modelle des Spiels in Worker-Threads: load() stellt eine OBJ-Datei in die Warteschlange,
+//   ein Worker mappt ihren Cache (oder parst die OBJ-Datei und schreibt den Cache, siehe mesh_cache.h),
+//   take_loaded() gibt die fertigen Meshes an den GL-Thread zum Hochladen weiter.
+// Der GL-Thread wartet dabei nie auf einen Worker, bis zum Hochladen zeichnet der Renderer einen Platzhalter.
+// Jede Datei darf nur einmal angefordert werden, zwei Worker wuerden sonst denselben Cache schreiben.
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mesh_cache.h"
+
+struct LoadedMesh {
+  std::string path;                  // wie an load() uebergeben
+  std::unique_ptr<CachedMesh> mesh;  // nullptr, falls die OBJ-Datei fehlerhaft ist (out_of_range, ...)
+};
+
+class AssetLoader {
+  std::mutex mutex;
+  std::condition_variable requested;   // neue Datei in pending oder stopping
+  std::deque<std::string> pending;     // angefordert, von keinem Worker begonnen
+  std::vector<LoadedMesh> loaded;      // fertig, noch nicht abgeholt
+  size_t loading = 0;                  // von Workern begonnen, noch nicht fertig
+  bool stopping = false;
+  std::vector<std::jthread> workers;
+
+  void work();
+public:
+  // threads = 0: ein Worker je Prozessorkern, hoechstens 4
+  explicit AssetLoader(unsigned int threads = 0);
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader & operator=(const AssetLoader &) = delete;
+  // nicht begonnene Dateien werden verworfen, begonnene zu Ende geladen
+  ~AssetLoader();
+
+  void load(const std::string & path);
+
+  // alle seit dem letzten Aufruf fertigen Meshes, wartet nicht
+  std::vector<LoadedMesh> take_loaded();
+
+  // true, wenn alle angeforderten Dateien geladen und abgeholt sind
+  bool is_idle();
+};
+
+#endif
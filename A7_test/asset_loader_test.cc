@@ -0,0 +1,80 @@
+#include "asset_loader.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+
+namespace {
+
+// eine Kopie der OBJ-Datei (mit Materialien) in einem temporaeren Ordner, ohne Cache
+std::string copy_to_temporary(const std::string & file) {
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "asset_loader_test";
+  std::filesystem::create_directories(folder);
+  for (const std::string & name : {file + ".obj", file + ".mtl"}) {
+    std::filesystem::copy_file(name, folder / name, std::filesystem::copy_options::overwrite_existing);
+  }
+  const std::filesystem::path copy = folder / (file + ".obj");
+  std::filesystem::remove(CachedMesh::cache_path(copy.string()));
+  return copy.string();
+}
+
+// holt die fertigen Meshes ab, bis alle geladen sind (hoechstens eine Minute)
+std::map<std::string, std::unique_ptr<CachedMesh>> take_all(AssetLoader & loader) {
+  std::map<std::string, std::unique_ptr<CachedMesh>> meshes;
+  const auto end = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+  while (!loader.is_idle() && std::chrono::steady_clock::now() < end) {
+    for (LoadedMesh & loaded : loader.take_loaded()) {
+      meshes[loaded.path] = std::move(loaded.mesh);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return meshes;
+}
+
+// die Worker liefern dieselben Daten wie ein CachedMesh im aufrufenden Thread
+TEST(ASSET_LOADER, LoadsInWorkers) {
+  std::vector<std::string> paths;
+  for (const std::string file : {"space_ship", "asteroid", "torpedo", "ufo"}) {
+    paths.push_back(copy_to_temporary(file));
+  }
+  AssetLoader loader(2);
+  for (const std::string & path : paths) {
+    loader.load(path);
+  }
+  std::map<std::string, std::unique_ptr<CachedMesh>> meshes = take_all(loader);
+  ASSERT_TRUE(loader.is_idle());
+  ASSERT_EQ(paths.size(), meshes.size());
+  for (const std::string & path : paths) {
+    const CachedMesh & loaded = *meshes.at(path);
+    ASSERT_TRUE(loaded.is_created()) << path;
+    CachedMesh mapped(path);
+    ASSERT_FALSE(mapped.is_created()) << path;
+    ASSERT_LT(0, loaded.get_indices().size()) << path;
+    ASSERT_TRUE(std::ranges::equal(mapped.get_vertices(), loaded.get_vertices())) << path;
+    ASSERT_TRUE(std::ranges::equal(mapped.get_indices(), loaded.get_indices())) << path;
+  }
+  ASSERT_TRUE(loader.take_loaded().empty());
+}
+
+TEST(ASSET_LOADER, MissingFile) {
+  AssetLoader loader(1);
+  loader.load("does_not_exist.obj");
+  std::map<std::string, std::unique_ptr<CachedMesh>> meshes = take_all(loader);
+  ASSERT_EQ(1, meshes.size());
+  ASSERT_EQ(0, meshes.at("does_not_exist.obj")->get_indices().size());
+}
+
+// der Destruktor verwirft die nicht begonnenen Dateien und wartet auf die begonnenen
+TEST(ASSET_LOADER, DestroyedWhileLoading) {
+  const std::string path = copy_to_temporary("ufo");
+  for (int i = 0; i < 20; i++) {
+    AssetLoader loader(2);
+    loader.load(path);
+    for (int j = 0; j < 10; j++) {
+      loader.load("does_not_exist.obj");
+    }
+  }
+}
+
+}
@@ -0,0 +1,130 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+// Policies fuer die Winkel- und Wurzelfunktionen von Vector und den Spielobjekten
+// StdMath ruft die Funktionen aus <cmath> auf (Standard, Ergebnisse wie bisher).
+// FastMath verwendet Polynome ohne Verzweigungen und ohne Tabellen, die Schleifen ueber
+//   viele Werte kann der Compiler daher vektorisieren (GCC 12 ab -O3). Gemessene Fehlerschranken (float,
+//   siehe fast_math_test.cc):
+//     sin, cos:  absoluter Fehler < 2e-7 fuer |x| <= 8192, danach waechst der Fehler der
+//                Argumentreduktion mit |x|
+//     atan2:     absoluter Fehler < 2e-6 rad, atan2(0, 0) = 0
+//     rsqrt:     relativer Fehler < 5e-6 fuer normalisierte x > 0
+//     sqrt:      relativer Fehler < 5e-6 fuer normalisierte x > 0, sqrt(0) = 0
+// Negative Argumente von sqrt und rsqrt liefern unbrauchbare Werte (nicht NaN).
+// Auch mit double rechnet FastMath nur mit float-Genauigkeit.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <numbers>
+
+// eine Policy stellt sin, cos, sincos, atan2, sqrt und rsqrt als statische Funktionen bereit
+template <class MATH>
+concept MathPolicy = requires(float x, float & s, float & c) {
+  { MATH::sin(x) } -> std::same_as<float>;
+  { MATH::cos(x) } -> std::same_as<float>;
+  MATH::sincos(x, s, c);
+  { MATH::atan2(x, x) } -> std::same_as<float>;
+  { MATH::sqrt(x) } -> std::same_as<float>;
+  { MATH::rsqrt(x) } -> std::same_as<float>;
+};
+
+struct StdMath {
+  template <class T> static T sin(T x) { return std::sin(x); }
+  template <class T> static T cos(T x) { return std::cos(x); }
+  template <class T> static void sincos(T x, T & s, T & c) { s = std::sin(x); c = std::cos(x); }
+  template <class T> static T atan2(T y, T x) { return std::atan2(y, x); }
+  template <class T> static T sqrt(T x) { return std::sqrt(x); }
+  template <class T> static T rsqrt(T x) { return static_cast<T>(1) / std::sqrt(x); }
+};
+
+struct FastMath {
+  // Argumentreduktion x = k * pi/2 + r mit |r| <= pi/4, pi/2 ist in drei Teile zerlegt,
+  //   damit k * PI_2_A und k * PI_2_B exakt sind (Cody-Waite); Koeffizienten aus Cephes (sinf, cosf)
+  template <class T>
+  static void sincos(T x, T & s, T & c) {
+    const float PI_2_A = 1.5703125f;
+    const float PI_2_B = 4.837512969970703125e-4f;
+    const float PI_2_C = 7.54978995489188216e-8f;
+    const float xf = static_cast<float>(x);
+    const float scaled = xf * static_cast<float>(2.0 / std::numbers::pi);
+    // Runden zur naechsten ganzen Zahl ohne Verzweigung (|scaled| < 2^22)
+    const float kf = (scaled + 12582912.0f) - 12582912.0f;
+    const int32_t k = static_cast<int32_t>(kf);
+    const float r = ((xf - kf * PI_2_A) - kf * PI_2_B) - kf * PI_2_C;
+    const float r2 = r * r;
+    const float sin_r = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    const float cos_r = 1.0f - 0.5f * r2
+                        + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+    // Quadrant k mod 4: (sin, cos) = (s, c), (c, -s), (-s, -c), (-c, s)
+    // die Vorzeichen werden ueber das Vorzeichenbit gesetzt
+    const bool swap = (k & 1) != 0;
+    const float sin_abs = swap ? cos_r : sin_r;
+    const float cos_abs = swap ? sin_r : cos_r;
+    const uint32_t sin_sign = static_cast<uint32_t>(k & 2) << 30;
+    const uint32_t cos_sign = static_cast<uint32_t>((k + 1) & 2) << 30;
+    s = static_cast<T>(std::bit_cast<float>(std::bit_cast<uint32_t>(sin_abs) ^ sin_sign));
+    c = static_cast<T>(std::bit_cast<float>(std::bit_cast<uint32_t>(cos_abs) ^ cos_sign));
+  }
+
+  template <class T>
+  static T sin(T x) {
+    T s, c;
+    sincos(x, s, c);
+    return s;
+  }
+
+  template <class T>
+  static T cos(T x) {
+    T s, c;
+    sincos(x, s, c);
+    return c;
+  }
+
+  // atan auf [0, 1] als Polynom vom Grad 11, der Rest ueber Symmetrien
+  // Vergleiche und Auswahl ueber die Bitdarstellung, nur dann kann der Compiler die Verzweigungen
+  //   ohne -fno-trapping-math entfernen; fuer |x|, |y| >= 0 ist die Ordnung der Bits dieselbe wie die der Zahlen
+  template <class T>
+  static T atan2(T y, T x) {
+    const uint32_t y_bits = std::bit_cast<uint32_t>(static_cast<float>(y));
+    const uint32_t x_bits = std::bit_cast<uint32_t>(static_cast<float>(x));
+    const uint32_t ay_bits = y_bits & 0x7fffffffu;
+    const uint32_t ax_bits = x_bits & 0x7fffffffu;
+    const bool swap = ay_bits > ax_bits;
+    const uint32_t max_bits = swap ? ay_bits : ax_bits;
+    const float minimum = std::bit_cast<float>(swap ? ax_bits : ay_bits);
+    // mindestens FLT_MIN, damit atan2(0, 0) = 0 ist (ungenau nur fuer denormalisierte x und y)
+    const float maximum = std::bit_cast<float>(std::max(max_bits, 0x00800000u));
+    const float a = minimum / maximum;
+    const float a2 = a * a;
+    float r = a * (0.99997726f + a2 * (-0.33262347f + a2 * (0.19354346f + a2 * (-0.11643287f
+                  + a2 * (0.05265332f + a2 * -0.01172120f)))));
+    r = (swap ? static_cast<float>(std::numbers::pi / 2) : 0.0f) + (swap ? -1.0f : 1.0f) * r;
+    const bool negative_x = (x_bits >> 31) != 0;
+    r = (negative_x ? static_cast<float>(std::numbers::pi) : 0.0f) + (negative_x ? -1.0f : 1.0f) * r;
+    return static_cast<T>(std::bit_cast<float>(std::bit_cast<uint32_t>(r) ^ (y_bits & 0x80000000u)));
+  }
+
+  // Startwert ueber die Bitdarstellung, danach zwei Newton-Schritte
+  template <class T>
+  static T rsqrt(T x) {
+    const float xf = static_cast<float>(x);
+    float r = std::bit_cast<float>(0x5f375a86 - (std::bit_cast<uint32_t>(xf) >> 1));
+    r = r * (1.5f - 0.5f * xf * r * r);
+    r = r * (1.5f - 0.5f * xf * r * r);
+    return static_cast<T>(r);
+  }
+
+  // x * rsqrt(x), x wird fuer rsqrt auf mindestens FLT_MIN gesetzt, damit sqrt(0) = 0 ist
+  template <class T>
+  static T sqrt(T x) {
+    const float xf = static_cast<float>(x);
+    const uint32_t bits = std::max(std::bit_cast<uint32_t>(xf), 0x00800000u);
+    return static_cast<T>(xf * rsqrt(std::bit_cast<float>(bits)));
+  }
+};
+
+#endif
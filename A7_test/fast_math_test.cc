@@ -0,0 +1,81 @@
+#include "math.h"
+#include "gtest/gtest.h"
+#include <cmath>
+
+namespace {
+
+// prueft die Fehlerschranken aus fast_math.h gegen die double-Funktionen aus <cmath>
+
+TEST(FAST_MATH, SinCosAccuracy) {
+  double max_sin_error = 0, max_cos_error = 0;
+  for (float x = -8192.0f; x <= 8192.0f; x += 0.0123f) {
+    float s, c;
+    FastMath::sincos(x, s, c);
+    max_sin_error = std::max(max_sin_error, std::fabs(s - std::sin(static_cast<double>(x))));
+    max_cos_error = std::max(max_cos_error, std::fabs(c - std::cos(static_cast<double>(x))));
+  }
+  EXPECT_LT(max_sin_error, 2e-7);
+  EXPECT_LT(max_cos_error, 2e-7);
+}
+
+TEST(FAST_MATH, SinCosQuadrants) {
+  const float quarter = static_cast<float>(PI / 2);
+  for (int k = -8; k <= 8; k++) {
+    float s, c;
+    FastMath::sincos(k * quarter + 0.3f, s, c);
+    EXPECT_NEAR(std::sin(k * quarter + 0.3f), s, 2e-7) << "k = " << k;
+    EXPECT_NEAR(std::cos(k * quarter + 0.3f), c, 2e-7) << "k = " << k;
+  }
+  EXPECT_EQ(0.0f, FastMath::sin(0.0f));
+  EXPECT_EQ(1.0f, FastMath::cos(0.0f));
+}
+
+TEST(FAST_MATH, Atan2Accuracy) {
+  double max_error = 0;
+  for (float y = -3.0f; y <= 3.0f; y += 0.0131f) {
+    for (float x = -3.0f; x <= 3.0f; x += 0.0173f) {
+      max_error = std::max(max_error, std::fabs(FastMath::atan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x))));
+    }
+  }
+  EXPECT_LT(max_error, 2e-6);
+  EXPECT_EQ(0.0f, FastMath::atan2(0.0f, 0.0f));
+  EXPECT_NEAR(static_cast<float>(PI), FastMath::atan2(0.0f, -1.0f), 1e-6f);
+  EXPECT_NEAR(-static_cast<float>(PI), FastMath::atan2(-0.0f, -1.0f), 1e-6f);
+  EXPECT_NEAR(static_cast<float>(PI / 2), FastMath::atan2(5.0f, 0.0f), 1e-6f);
+}
+
+TEST(FAST_MATH, SqrtAccuracy) {
+  double max_rsqrt_error = 0, max_sqrt_error = 0;
+  for (float x = 1e-30f; x < 1e30f; x *= 1.001f) {
+    const double expected = std::sqrt(static_cast<double>(x));
+    max_rsqrt_error = std::max(max_rsqrt_error, std::fabs(FastMath::rsqrt(x) * expected - 1.0));
+    max_sqrt_error = std::max(max_sqrt_error, std::fabs(FastMath::sqrt(x) / expected - 1.0));
+  }
+  EXPECT_LT(max_rsqrt_error, 5e-6);
+  EXPECT_LT(max_sqrt_error, 5e-6);
+  EXPECT_EQ(0.0f, FastMath::sqrt(0.0f));
+}
+
+TEST(FAST_MATH, StdMathPolicyMatchesVector) {
+  Vector2df v = {3.0f, -4.0f};
+  EXPECT_EQ(v.length(), v.length(StdMath{}));
+  EXPECT_EQ(Vector2df(0.7f)[0], Vector2df(0.7f, StdMath{})[0]);
+  EXPECT_EQ(Vector2df(0.7f)[1], Vector2df(0.7f, StdMath{})[1]);
+}
+
+TEST(FAST_MATH, VectorWithFastMathPolicy) {
+  Vector3df v = {1.0f, 2.0f, -2.0f};
+  EXPECT_NEAR(3.0f, v.length(FastMath{}), 3.0f * 5e-6f);
+
+  v.normalize(FastMath{});
+  EXPECT_NEAR(1.0f, v.length(), 1e-5f);
+  EXPECT_NEAR(-2.0f / 3.0f, v[2], 1e-5f);
+
+  Vector2df direction(2.5f, FastMath{});
+  EXPECT_NEAR(std::cos(2.5f), direction[0], 2e-7f);
+  EXPECT_NEAR(std::sin(2.5f), direction[1], 2e-7f);
+  EXPECT_NEAR(2.5f, direction.angle(0, 1, FastMath{}), 2e-6f);
+  EXPECT_NEAR(direction.angle(0, 1), (10.0f * direction).angle(0, 1, FastMath{}), 2e-6f);
+}
+
+}
@@ -44,6 +44,10 @@ Asteroid::Asteroid(short size)
     } else if (size == 1) { /* 3 - 6s */
       velocity *= 768.0f / 6.0f +  768.0f / 6.0f * dis(gen);
     }
+    // taumeln um eine zufaellige Achse mit 0.5 - 1.5 rad/s
+    Vector3df axis = { 0.5f - dis(gen), 0.5f - dis(gen), 0.5f - dis(gen) };
+    axis.normalize();
+    angular_velocity = (0.5f + dis(gen)) * axis;
 
   }
 
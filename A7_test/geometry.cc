@@ -2,16 +2,31 @@
 #include "geometry.tcc"
 
 template class Intersection_Context<float,3u>;
+template class Intersection_Context<double,3u>;
 
 template class Ray<float, 2u>;
 template class Ray<float, 3u>; 
+template class Ray<double, 2u>;
+template class Ray<double, 3u>;
+template class Ray<float, 4u>;
+template class Ray<double, 4u>;
 
 template class AxisAlignedBoundingBox<float, 2u>;
 template class AxisAlignedBoundingBox<float, 3u>; 
+template class AxisAlignedBoundingBox<double, 2u>;
+template class AxisAlignedBoundingBox<double, 3u>;
+template class AxisAlignedBoundingBox<float, 4u>;
+template class AxisAlignedBoundingBox<double, 4u>;
 
 template class Sphere<float, 2u>;
 template class Sphere<float, 3u>; 
+template class Sphere<double, 2u>;
+template class Sphere<double, 3u>;
+template class Sphere<float, 4u>;
+template class Sphere<double, 4u>;
 
 template class Triangle<float, 3u>; 
+template class Triangle<double, 3u>;
 
 template bool refract<float, 3u>(float refraction_index, Vector<float, 3u> normal, Vector<float, 3u> direction, Vector<float, 3> & transmission);
+template bool refract<double, 3u>(double refraction_index, Vector<double, 3u> normal, Vector<double, 3u> direction, Vector<double, 3> & transmission);
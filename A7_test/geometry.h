@@ -146,5 +146,16 @@ typedef Sphere<float, 3u> Sphere3df;
 
 typedef Triangle<float, 3u> Triangle3df;
 
+typedef Ray<double, 2u> Ray2dd;
+typedef Ray<double, 3u> Ray3dd;
+
+typedef AxisAlignedBoundingBox<double, 2u> AABB2dd;
+typedef AxisAlignedBoundingBox<double, 3u> AABB3dd;
+
+typedef Sphere<double, 2u> Sphere2dd;
+typedef Sphere<double, 3u> Sphere3dd;
+
+typedef Triangle<double, 3u> Triangle3dd;
+
 
 #endif
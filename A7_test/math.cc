@@ -8,6 +8,9 @@
 template class Vector<float, 2u>;
 template class Vector<float, 3u>; 
 template class Vector<float, 4u>;
+template class Vector<double, 2u>;
+template class Vector<double, 3u>;
+template class Vector<double, 4u>;
 
 
 // instantiations of each template function
@@ -15,18 +18,36 @@ template Vector<float, 2u> operator*(float scalar, Vector<float, 2u> value);
 template Vector<float, 2u> operator+(Vector<float, 2u> value, const Vector<float, 2u> addend);
 template Vector<float, 2u> operator-(Vector<float, 2u> value, const Vector<float, 2u> addend);
 
-//template float operator*(Vector<float, 2u> value, const Vector<float, 2u> addend);
+template float operator*(Vector<float, 2u> value, const Vector<float, 2u> addend);
 
 template Vector<float, 3u> operator*(float scalar, Vector<float, 3u> value);
 template Vector<float, 3u> operator+(Vector<float, 3u> value, const Vector<float, 3u> addend);
 template Vector<float, 3u> operator-(Vector<float, 3u> value, const Vector<float, 3u> addend);
 
-//template float operator*(Vector<float, 3u> value, const Vector<float, 3u> addend);
+template float operator*(Vector<float, 3u> value, const Vector<float, 3u> addend);
 
 template Vector<float, 4u> operator*(float scalar, Vector<float, 4u> value);
 template Vector<float, 4u> operator+(Vector<float, 4u> value, const Vector<float, 4u> addend);
 template Vector<float, 4u> operator-(Vector<float, 4u> value, const Vector<float, 4u> addend);
 
-//template float operator*(Vector<float, 4u> value, const Vector<float, 4u> addend);
+template float operator*(Vector<float, 4u> value, const Vector<float, 4u> addend);
+
+template Vector<double, 2u> operator*(double scalar, Vector<double, 2u> value);
+template Vector<double, 2u> operator+(Vector<double, 2u> value, const Vector<double, 2u> addend);
+template Vector<double, 2u> operator-(Vector<double, 2u> value, const Vector<double, 2u> addend);
+
+template double operator*(Vector<double, 2u> value, const Vector<double, 2u> addend);
+
+template Vector<double, 3u> operator*(double scalar, Vector<double, 3u> value);
+template Vector<double, 3u> operator+(Vector<double, 3u> value, const Vector<double, 3u> addend);
+template Vector<double, 3u> operator-(Vector<double, 3u> value, const Vector<double, 3u> addend);
+
+template double operator*(Vector<double, 3u> value, const Vector<double, 3u> addend);
+
+template Vector<double, 4u> operator*(double scalar, Vector<double, 4u> value);
+template Vector<double, 4u> operator+(Vector<double, 4u> value, const Vector<double, 4u> addend);
+template Vector<double, 4u> operator-(Vector<double, 4u> value, const Vector<double, 4u> addend);
+
+template double operator*(Vector<double, 4u> value, const Vector<double, 4u> addend);
 
 
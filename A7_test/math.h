@@ -5,10 +5,15 @@
 #include <array>
 #include <cstddef>
 #include <cmath>
+#include <cassert>
+#include "fast_math.h"
 
 // A Vector consisting of N scalar values of type FLOAT_TYPE
+// Vector4df is aligned to 16 bytes, such that it can be loaded into a SIMD register directly
+// all operations without std::cmath functions are constexpr and defined in this header,
+//   such that constant vectors can be computed at compile time
 template<class FLOAT_TYPE, size_t N>
-struct Vector {
+struct alignas(N == 4u && sizeof(FLOAT_TYPE) == 4u ? 16u : alignof(std::array<FLOAT_TYPE, N>)) Vector {
   static_assert(N > 0u); // no zero length vectors allowed
   
   // stores the N scalar values of this Vector
@@ -19,32 +24,40 @@ struct Vector {
   // if values is empty, then this->vector is initilized with zeros
   // if less than N values are given, then all remaining values of this->vector
   //   are initialized with the last given value 
-  Vector( std::initializer_list<FLOAT_TYPE> values );
+  constexpr Vector( std::initializer_list<FLOAT_TYPE> values );
   
-  // erstellt einen vector der nichts tut 
-  Vector();
+  // erstellt einen Nullvektor
+  constexpr Vector();
+
+  // converts a Vector of another scalar type, e.g. Vector2df(position) for a Vector2dd position
+  template <class OTHER>
+  constexpr explicit Vector(const Vector<OTHER, N> other);
 
   // creates a unit vector pointing to the given angle (in radians) in the x/y plane
   // angle = 0 points in the direction of the x-axis
   explicit Vector(FLOAT_TYPE angle);
 
+  // as above, sin and cos are computed by the policy MATH, e.g. Vector2df(angle, FastMath{})
+  template <MathPolicy MATH>
+  Vector(FLOAT_TYPE angle, MATH);
+
   // adds addend to this Vector and returns the resulting sum
-  Vector & operator+=(const Vector addend);
+  constexpr Vector & operator+=(const Vector addend);
 
   // subtracts minuend from this Vector and returns the resulting difference
-  Vector & operator-=(const Vector minuend);
+  constexpr Vector & operator-=(const Vector minuend);
 
   // multiplies the scalar factor to this vector and returns the result
-  Vector & operator*=(const FLOAT_TYPE factor);
+  constexpr Vector & operator*=(const FLOAT_TYPE factor);
 
   // divides this vector by the given factor and returns the result
-  Vector & operator/=(const FLOAT_TYPE factor);
+  constexpr Vector & operator/=(const FLOAT_TYPE factor);
 
   // returns the reference of the i-th scalar component of this vector      
-  FLOAT_TYPE & operator[](std::size_t i);
+  constexpr FLOAT_TYPE & operator[](std::size_t i);
 
   // returns the i-th scalar component of this Vector
-  FLOAT_TYPE operator[](std::size_t i) const;
+  constexpr FLOAT_TYPE operator[](std::size_t i) const;
 
   // returns the i-th scalar component of this Vector
   // throws an exception if i >= N
@@ -52,6 +65,10 @@ struct Vector {
   
   // normalize this Vector to the length 1  
   void normalize();
+
+  // normalize this Vector with the reciprocal square root of the policy MATH
+  template <MathPolicy MATH>
+  void normalize(MATH);
   
   // returns the specular reflective "ray" Vector wrt the give normal vector
   // normal must be a normalized vector
@@ -60,33 +77,199 @@ struct Vector {
   // returns the angle of this Vector between the two given axis in radians
   FLOAT_TYPE angle(size_t axis_1, size_t axis_2) const;
 
+  // as above, atan2 is computed by the policy MATH
+  template <MathPolicy MATH>
+  FLOAT_TYPE angle(size_t axis_1, size_t axis_2, MATH) const;
+
   // returns the cross product of this Vector with the Vector v
   // only three-dimensional case
-  Vector<FLOAT_TYPE, 3u> cross_product(const Vector<FLOAT_TYPE, 3u> v) const;
+  constexpr Vector<FLOAT_TYPE, 3u> cross_product(const Vector<FLOAT_TYPE, 3u> v) const;
   
   // returns the scalar product of the given scalar and value
   template <class F, size_t K>    
-  friend Vector<F, K> operator*(F scalar, Vector<F, K> value);
+  friend constexpr Vector<F, K> operator*(F scalar, Vector<F, K> value);
 
   // returns the vector sum of the to given vectors
   template <class F, size_t K>    
-  friend Vector<F, K> operator+(const Vector<F, K> value, const Vector<F, K> addend);
+  friend constexpr Vector<F, K> operator+(const Vector<F, K> value, const Vector<F, K> addend);
 
   // returns the vector difference value - minuend
   template <class F, size_t K>    
-  friend Vector<F, K> operator-(const Vector<F, K> value, const Vector<F, K> minuend);
+  friend constexpr Vector<F, K> operator-(const Vector<F, K> value, const Vector<F, K> minuend);
 
   // returns the (euclidian) length of this Vector
   FLOAT_TYPE length() const;
+
+  // as above, the square root is computed by the policy MATH
+  template <MathPolicy MATH>
+  FLOAT_TYPE length(MATH) const;
   
   // returns the square of the this Vector's length
-  FLOAT_TYPE square_of_length() const;
+  constexpr FLOAT_TYPE square_of_length() const;
  
   // returns the scalar (inner) product of two Vectors
   template <class F, size_t K>    
-  friend F operator*(Vector<F, K> vector1, const Vector<F, K> vector2);
+  friend constexpr F operator*(Vector<F, K> vector1, const Vector<F, K> vector2);
 };
 
+// constexpr-Definitionen muessen in jeder Uebersetzungseinheit sichtbar sein,
+//   alle anderen Definitionen stehen in math.tcc
+
+template <class FLOAT_TYPE, size_t N>
+constexpr Vector<FLOAT_TYPE, N>::Vector( std::initializer_list<FLOAT_TYPE> values ) {
+  auto iterator = values.begin();
+  for (size_t i = 0u; i < N; i++) {
+    if ( iterator != values.end()) {
+      vector[i] = *iterator++;
+    } else {
+      vector[i] = (i > 0 ? vector[i - 1] : 0.0);
+    }
+  }
+}
+
+template <class FLOAT_TYPE, size_t N>
+constexpr Vector<FLOAT_TYPE, N>::Vector() {
+  vector.fill(0.0);
+}
+
+template <class FLOAT_TYPE, size_t N>
+template <class OTHER>
+constexpr Vector<FLOAT_TYPE, N>::Vector(const Vector<OTHER, N> other) {
+  for (size_t i = 0u; i < N; i++) {
+    vector[i] = static_cast<FLOAT_TYPE>(other.vector[i]);
+  }
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr Vector<FLOAT_TYPE, N> & Vector<FLOAT_TYPE, N>::operator+=(const Vector<FLOAT_TYPE, N> addend) {
+  for (size_t i = 0u; i < N; i++) {
+    vector[i] += addend.vector[i];
+  }
+  return *this;
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr Vector<FLOAT_TYPE, N> & Vector<FLOAT_TYPE, N>::operator-=(const Vector<FLOAT_TYPE, N> minuend) {
+  for (size_t i = 0u; i < N; i++) {
+    vector[i] -= minuend.vector[i];
+  }
+  return *this;
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr Vector<FLOAT_TYPE, N> & Vector<FLOAT_TYPE, N>::operator*=(const FLOAT_TYPE factor) {
+  for (size_t i = 0u; i < N; i++) {
+    vector[i] *= factor;
+  }
+  return *this;
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr Vector<FLOAT_TYPE, N> & Vector<FLOAT_TYPE, N>::operator/=(const FLOAT_TYPE factor) {
+  for (size_t i = 0u; i < N; i++) {
+    vector[i] /= factor;
+  }
+  return *this;
+}
+
+template <class FLOAT_TYPE, size_t N>    
+constexpr Vector<FLOAT_TYPE, N> operator*(FLOAT_TYPE scalar, Vector<FLOAT_TYPE, N> value) {
+  Vector<FLOAT_TYPE, N> scalar_product = value;
+
+  scalar_product *= scalar;
+
+  return scalar_product;
+}
+
+template <class FLOAT_TYPE, size_t N>    
+constexpr Vector<FLOAT_TYPE, N> operator+(const Vector<FLOAT_TYPE, N> value, const Vector<FLOAT_TYPE, N> addend) {
+  Vector<FLOAT_TYPE, N> sum = value;
+  sum += addend;
+  return sum;
+}
+
+template <class FLOAT_TYPE, size_t N>    
+constexpr Vector<FLOAT_TYPE, N> operator-(const Vector<FLOAT_TYPE, N> value, const Vector<FLOAT_TYPE, N> minuend) {
+  Vector<FLOAT_TYPE, N> difference = value;
+  difference -= minuend;
+  return difference;
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr FLOAT_TYPE & Vector<FLOAT_TYPE, N>::operator[](std::size_t i) {
+  return vector[i];
+}
+
+template <class FLOAT_TYPE, size_t N>  
+constexpr FLOAT_TYPE Vector<FLOAT_TYPE, N>::operator[](std::size_t i) const {
+  return vector[i];
+}
+
+template <class FLOAT_TYPE, size_t N>
+constexpr Vector<FLOAT_TYPE, 3u> Vector<FLOAT_TYPE, N>::cross_product(const Vector<FLOAT_TYPE, 3u> v) const {
+  assert(N >= 3u);
+  return {this->vector[1] * v.vector[2] - this->vector[2] * v.vector[1],
+          this->vector[0] * v.vector[2] - this->vector[2] * v.vector[0],
+          this->vector[0] * v.vector[1] - this->vector[1] * v.vector[0] };
+}
+
+template <class FLOAT_TYPE, size_t N>
+constexpr FLOAT_TYPE Vector<FLOAT_TYPE, N>::square_of_length() const {
+  FLOAT_TYPE sum = 0;
+  for(size_t i=0; i<N;i++){sum += (vector[i] * vector[i]);}
+  return sum;
+}
+
+template <class F, size_t K>
+constexpr F operator*(Vector<F, K> vector1, const Vector<F, K> vector2) {
+  F sum = 0;
+  for (size_t i = 0; i < K; i++) {
+    sum += vector1.vector[i] * vector2.vector[i];
+  }
+  return sum;
+}
+
+// die Methoden mit Policy sind fuer beliebige Policies hier definiert
+
+template <class FLOAT_TYPE, size_t N>
+template <MathPolicy MATH>
+Vector<FLOAT_TYPE, N>::Vector(FLOAT_TYPE angle, MATH) {
+  FLOAT_TYPE sin_angle, cos_angle;
+  MATH::sincos(angle, sin_angle, cos_angle);
+  // wie *this = {cos, sin}, ohne initializer_list
+  vector[0] = cos_angle;
+  for (size_t i = 1; i < N; i++) {
+    vector[i] = sin_angle;
+  }
+}
+
+template <class FLOAT_TYPE, size_t N>
+template <MathPolicy MATH>
+void Vector<FLOAT_TYPE, N>::normalize(MATH) {
+  *this *= MATH::rsqrt(square_of_length());
+}
+
+template <class FLOAT_TYPE, size_t N>
+template <MathPolicy MATH>
+FLOAT_TYPE Vector<FLOAT_TYPE, N>::angle(size_t axis_1, size_t axis_2, MATH) const {
+  // atan2 haengt nicht von der Laenge ab, normalisieren ist nicht noetig
+  return MATH::atan2(vector[axis_2], vector[axis_1]);
+}
+
+template <class FLOAT_TYPE, size_t N>
+template <MathPolicy MATH>
+FLOAT_TYPE Vector<FLOAT_TYPE, N>::length(MATH) const {
+  return MATH::sqrt(square_of_length());
+}
+
+// Mischbetrieb fuer grosse Welten: Positionen in double, der Renderer rechnet mit float
+// die Differenz wird in double gebildet und erst danach gerundet, dadurch bleiben Objekte nahe
+//   origin (z.B. der Kamera) auch weit weg vom Ursprung der Welt genau
+template <class FLOAT_TYPE, size_t N>
+constexpr Vector<float, N> relative_to(const Vector<FLOAT_TYPE, N> position, const Vector<FLOAT_TYPE, N> origin) {
+  return Vector<float, N>(position - origin);
+}
+
 static const long double PI = std::acos(-1.0L);
 
 // shorter comfortable type names
@@ -94,4 +277,44 @@ typedef Vector<float, 2u> Vector2df;
 typedef Vector<float, 3u> Vector3df;
 typedef Vector<float, 4u> Vector4df;
 
+typedef Vector<double, 2u> Vector2dd;
+typedef Vector<double, 3u> Vector3dd;
+typedef Vector<double, 4u> Vector4dd;
+
+#include "math_simd.h"
+
+// die Instanziierungen fuer float und double (N = 2, 3, 4) liegen vorkompiliert in math.cc,
+//   die anderen Uebersetzungseinheiten instanziieren sie nicht noch einmal
+// erst nach math_simd.h, die Spezialisierungen muessen vorher deklariert sein
+extern template class Vector<float, 2u>;
+extern template class Vector<float, 3u>;
+extern template class Vector<float, 4u>;
+extern template class Vector<double, 2u>;
+extern template class Vector<double, 3u>;
+extern template class Vector<double, 4u>;
+
+extern template Vector<float, 2u> operator*(float scalar, Vector<float, 2u> value);
+extern template Vector<float, 2u> operator+(Vector<float, 2u> value, const Vector<float, 2u> addend);
+extern template Vector<float, 2u> operator-(Vector<float, 2u> value, const Vector<float, 2u> addend);
+extern template float operator*(Vector<float, 2u> value, const Vector<float, 2u> addend);
+// das Skalarprodukt fuer float mit N = 3, 4 kann in math_simd.h spezialisiert sein
+extern template Vector<float, 3u> operator*(float scalar, Vector<float, 3u> value);
+extern template Vector<float, 3u> operator+(Vector<float, 3u> value, const Vector<float, 3u> addend);
+extern template Vector<float, 3u> operator-(Vector<float, 3u> value, const Vector<float, 3u> addend);
+extern template Vector<float, 4u> operator*(float scalar, Vector<float, 4u> value);
+extern template Vector<float, 4u> operator+(Vector<float, 4u> value, const Vector<float, 4u> addend);
+extern template Vector<float, 4u> operator-(Vector<float, 4u> value, const Vector<float, 4u> addend);
+extern template Vector<double, 2u> operator*(double scalar, Vector<double, 2u> value);
+extern template Vector<double, 2u> operator+(Vector<double, 2u> value, const Vector<double, 2u> addend);
+extern template Vector<double, 2u> operator-(Vector<double, 2u> value, const Vector<double, 2u> addend);
+extern template double operator*(Vector<double, 2u> value, const Vector<double, 2u> addend);
+extern template Vector<double, 3u> operator*(double scalar, Vector<double, 3u> value);
+extern template Vector<double, 3u> operator+(Vector<double, 3u> value, const Vector<double, 3u> addend);
+extern template Vector<double, 3u> operator-(Vector<double, 3u> value, const Vector<double, 3u> addend);
+extern template double operator*(Vector<double, 3u> value, const Vector<double, 3u> addend);
+extern template Vector<double, 4u> operator*(double scalar, Vector<double, 4u> value);
+extern template Vector<double, 4u> operator+(Vector<double, 4u> value, const Vector<double, 4u> addend);
+extern template Vector<double, 4u> operator-(Vector<double, 4u> value, const Vector<double, 4u> addend);
+extern template double operator*(Vector<double, 4u> value, const Vector<double, 4u> addend);
+
 #endif
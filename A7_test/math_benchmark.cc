@@ -0,0 +1,362 @@
+#include "math.h"
+#include "matrix.h"
+#include "quaternion.h"
+#include "transform.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Microbenchmarks fuer die Vektor- und Matrixoperationen
+// math_benchmark nutzt die SIMD-Spezialisierungen, math_benchmark_generic wird mit MATH_NO_SIMD
+//   uebersetzt und misst die generischen Templates; Vergleich z.B. mit
+//   compare.py benchmarks generic.json simd.json
+
+namespace {
+
+const size_t COUNT = 1024u;
+
+std::vector<Vector4df> create_vectors4() {
+  std::vector<Vector4df> vectors;
+  for (size_t i = 0; i < COUNT; i++) {
+    float f = static_cast<float>(i);
+    vectors.push_back({f * 0.5f + 1.0f, 3.0f - f, f * f * 0.01f, 1.0f});
+  }
+  return vectors;
+}
+
+std::vector<Vector3df> create_vectors3() {
+  std::vector<Vector3df> vectors;
+  for (const Vector4df & v : create_vectors4()) {
+    vectors.push_back({v[0], v[1], v[2]});
+  }
+  return vectors;
+}
+
+SquareMatrix4df create_matrix() {
+  return { {0.9f, 0.1f, 0.0f, 0.0f},
+           {-0.1f, 0.9f, 0.2f, 0.0f},
+           {0.0f, -0.2f, 0.95f, 0.0f},
+           {4.0f, -3.0f, 2.0f, 1.0f} };
+}
+
+void BM_ScalarProduct4df(benchmark::State & state) {
+  auto vectors = create_vectors4();
+  for (auto _ : state) {
+    float sum = 0;
+    for (size_t i = 1; i < COUNT; i++) {
+      sum += vectors[i - 1] * vectors[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+BENCHMARK(BM_ScalarProduct4df);
+
+void BM_ScalarProduct3df(benchmark::State & state) {
+  auto vectors = create_vectors3();
+  for (auto _ : state) {
+    float sum = 0;
+    for (size_t i = 1; i < COUNT; i++) {
+      sum += vectors[i - 1] * vectors[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+BENCHMARK(BM_ScalarProduct3df);
+
+void BM_Normalize4df(benchmark::State & state) {
+  auto vectors = create_vectors4();
+  for (auto _ : state) {
+    for (Vector4df & v : vectors) {
+      v.normalize();
+    }
+    benchmark::DoNotOptimize(vectors.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_Normalize4df);
+
+void BM_Normalize3df(benchmark::State & state) {
+  auto vectors = create_vectors3();
+  for (auto _ : state) {
+    for (Vector3df & v : vectors) {
+      v.normalize();
+    }
+    benchmark::DoNotOptimize(vectors.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_Normalize3df);
+
+void BM_CrossProduct3df(benchmark::State & state) {
+  auto vectors = create_vectors3();
+  std::vector<Vector3df> result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 1; i < COUNT; i++) {
+      result[i] = vectors[i - 1].cross_product(vectors[i]);
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+BENCHMARK(BM_CrossProduct3df);
+
+void BM_MatrixVector4df(benchmark::State & state) {
+  auto vectors = create_vectors4();
+  SquareMatrix4df matrix = create_matrix();
+  std::vector<Vector4df> result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = matrix * vectors[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_MatrixVector4df);
+
+void BM_MatrixMatrix4df(benchmark::State & state) {
+  SquareMatrix4df factor = create_matrix();
+  for (auto _ : state) {
+    SquareMatrix4df product = create_matrix();
+    for (size_t i = 0; i < COUNT; i++) {
+      product = factor * product;
+    }
+    benchmark::DoNotOptimize(product);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_MatrixMatrix4df);
+
+void BM_Inverse4df(benchmark::State & state) {
+  SquareMatrix4df matrix = create_matrix();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    SquareMatrix4df inverse = matrix.inverse();
+    benchmark::DoNotOptimize(inverse);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Inverse4df);
+
+void BM_AffineInverse4df(benchmark::State & state) {
+  SquareMatrix4df matrix = create_matrix();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    SquareMatrix4df inverse = matrix.affine_inverse();
+    benchmark::DoNotOptimize(inverse);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AffineInverse4df);
+
+void BM_NormalMatrix4df(benchmark::State & state) {
+  SquareMatrix4df matrix = create_matrix();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    SquareMatrix3df normal_matrix = matrix.normal_matrix();
+    benchmark::DoNotOptimize(normal_matrix);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NormalMatrix4df);
+
+// Objekttransformation wie in TypedBodyView: translation * rotation * scaling * achsen_korrektur
+void BM_ObjectTransformMatrix4df(benchmark::State & state) {
+  SquareMatrix4df korrektur = create_matrix();
+  SquareMatrix4df world = create_matrix();
+  float angle = 0.0f;
+  for (auto _ : state) {
+    SquareMatrix4df translation = { {1.0f, 0.0f, 0.0f, 0.0f},
+                                    {0.0f, 1.0f, 0.0f, 0.0f},
+                                    {0.0f, 0.0f, 1.0f, 0.0f},
+                                    {angle, 2.0f, 0.0f, 1.0f} };
+    SquareMatrix4df rotation = { { std::cos(angle), std::sin(angle), 0.0f, 0.0f},
+                                 {-std::sin(angle), std::cos(angle), 0.0f, 0.0f},
+                                 { 0.0f,            0.0f,            1.0f, 0.0f},
+                                 { 0.0f,            0.0f,            0.0f, 1.0f} };
+    SquareMatrix4df scaling = { {16.0f, 0.0f,  0.0f,  0.0f},
+                                {0.0f,  16.0f, 0.0f,  0.0f},
+                                {0.0f,  0.0f,  16.0f, 0.0f},
+                                {0.0f,  0.0f,  0.0f,  1.0f} };
+    SquareMatrix4df transform = world * (translation * rotation * scaling * korrektur);
+    benchmark::DoNotOptimize(transform);
+    angle += 0.001f;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectTransformMatrix4df);
+
+void BM_ObjectTransformAffine3df(benchmark::State & state) {
+  Affine3df korrektur = Affine3df(create_matrix());
+  SquareMatrix4df world = create_matrix();
+  float angle = 0.0f;
+  for (auto _ : state) {
+    Affine3df trs = Affine3df::from_trs({angle, 2.0f, 0.0f}, angle, 16.0f);
+    SquareMatrix4df transform = world * (trs * korrektur).to_matrix();
+    benchmark::DoNotOptimize(transform);
+    angle += 0.001f;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectTransformAffine3df);
+
+// taumelnder Asteroid: Orientierung integrieren, mit der Drehung um z verknuepfen, in eine Matrix umwandeln
+void BM_ObjectTransformQuaternion(benchmark::State & state) {
+  Affine3df korrektur = Affine3df(create_matrix());
+  SquareMatrix4df world = create_matrix();
+  Quaterniondf orientation;
+  const Quaterniondf rotation_z = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 0.3f);
+  float x = 0.0f;
+  for (auto _ : state) {
+    orientation.integrate({0.6f, 0.0f, 0.8f}, 1.0f / 60.0f);
+    SquareMatrix4df transform = world * ((rotation_z * orientation).to_affine({x, 2.0f, 0.0f}, 16.0f) * korrektur).to_matrix();
+    benchmark::DoNotOptimize(transform);
+    x += 0.001f;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectTransformQuaternion);
+
+void BM_QuaternionProduct(benchmark::State & state) {
+  Quaterniondf q1 = Quaterniondf::from_axis_angle({0.6f, 0.0f, 0.8f}, 2.1f);
+  Quaterniondf q2 = Quaterniondf::from_axis_angle({0.0f, 1.0f, 0.0f}, -0.4f);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q1);
+    benchmark::DoNotOptimize(q2);
+    Quaterniondf product = q1 * q2;
+    benchmark::DoNotOptimize(product);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuaternionProduct);
+
+// Winkel- und Wurzelfunktionen: <cmath> (StdMath) gegen die Polynome aus fast_math.h
+std::vector<float> create_angles() {
+  std::vector<float> angles;
+  for (size_t i = 0; i < COUNT; i++) {
+    angles.push_back(static_cast<float>(i) * 0.037f - 19.0f);
+  }
+  return angles;
+}
+
+template <class MATH>
+void BM_SinCos(benchmark::State & state) {
+  auto angles = create_angles();
+  std::vector<float> sines(COUNT), cosines(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      MATH::sincos(angles[i], sines[i], cosines[i]);
+    }
+    benchmark::DoNotOptimize(sines.data());
+    benchmark::DoNotOptimize(cosines.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_SinCos<StdMath>);
+BENCHMARK(BM_SinCos<FastMath>);
+
+template <class MATH>
+void BM_Atan2(benchmark::State & state) {
+  auto angles = create_angles();
+  std::vector<float> result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 1; i < COUNT; i++) {
+      result[i] = MATH::atan2(angles[i], angles[i - 1]);
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+BENCHMARK(BM_Atan2<StdMath>);
+BENCHMARK(BM_Atan2<FastMath>);
+
+template <class MATH>
+void BM_Rsqrt(benchmark::State & state) {
+  auto angles = create_angles();
+  std::vector<float> result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = MATH::rsqrt(angles[i] * angles[i] + 1.0f);
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_Rsqrt<StdMath>);
+BENCHMARK(BM_Rsqrt<FastMath>);
+
+// Richtungsvektor und Winkel wie in Body::accelerate und Vector::angle
+template <class MATH>
+void BM_VectorAngle2df(benchmark::State & state) {
+  auto angles = create_angles();
+  float sum = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      sum += Vector2df(angles[i], MATH{}).angle(0, 1, MATH{});
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_VectorAngle2df<StdMath>);
+BENCHMARK(BM_VectorAngle2df<FastMath>);
+
+// Arguments: Anzahl der Punkte, Anzahl der Threads (0 = alle Prozessorkerne)
+void BM_TransformPoints3df(benchmark::State & state) {
+  const size_t count = state.range(0);
+  std::vector<Vector3df> points(count, Vector3df{1.0f, -2.0f, 3.0f});
+  std::vector<Vector3df> result(count);
+  SquareMatrix4df matrix = create_matrix();
+  for (auto _ : state) {
+    transform_points(matrix, points, result, state.range(1));
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * count * 2 * sizeof(Vector3df));
+}
+BENCHMARK(BM_TransformPoints3df)->ArgsProduct({{1000, 10000, 100000, 1000000, 10000000}, {1, 0}})
+                                ->Unit(benchmark::kMicrosecond);
+
+// dieselbe Rechnung Punkt fuer Punkt mit SquareMatrix::operator*
+void BM_TransformPointsLoop3df(benchmark::State & state) {
+  const size_t count = state.range(0);
+  std::vector<Vector3df> points(count, Vector3df{1.0f, -2.0f, 3.0f});
+  std::vector<Vector3df> result(count);
+  SquareMatrix4df matrix = create_matrix();
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; i++) {
+      Vector4df p = matrix * Vector4df{points[i][0], points[i][1], points[i][2], 1.0f};
+      result[i] = {p[0], p[1], p[2]};
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformPointsLoop3df)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_TransformPoints2df(benchmark::State & state) {
+  const size_t count = state.range(0);
+  std::vector<Vector2df> points(count, Vector2df{1.0f, -2.0f});
+  std::vector<Vector2df> result(count);
+  SquareMatrix3df matrix = { {0.8f, 0.6f, 0.0f}, {-0.6f, 0.8f, 0.0f}, {512.0f, 384.0f, 1.0f} };
+  for (auto _ : state) {
+    transform_points(matrix, points, result, state.range(1));
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformPoints2df)->ArgsProduct({{1000, 10000, 100000, 1000000, 10000000}, {1, 0}})
+                                ->Unit(benchmark::kMicrosecond);
+
+}
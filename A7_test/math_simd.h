@@ -0,0 +1,154 @@
+#ifndef MATH_SIMD_H
+#define MATH_SIMD_H
+
+// SIMD-Spezialisierungen fuer Vector3df und Vector4df (SSE auf x86, NEON auf AArch64)
+// Die Ergebnisse sind bitgenau gleich zu den generischen Templates in math.tcc:
+//   die Produkte werden parallel berechnet, die Summen aber in derselben Reihenfolge
+//   wie in den Schleifen (0 + p0 + p1 + ...) gebildet.
+// Mit -DMATH_NO_SIMD werden nur die generischen Templates verwendet.
+// Bei der Auswertung zur Compile-Zeit rechnen die constexpr-Spezialisierungen skalar.
+
+#include "math.h"
+#include <type_traits>
+
+#if !defined(MATH_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || defined(__aarch64__))
+#define MATH_SIMD 1
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#include <xmmintrin.h>
+#endif
+
+namespace simd {
+
+#if defined(__aarch64__)
+
+typedef float32x4_t float4;
+
+inline float4 load(const Vector4df & v) { return vld1q_f32(v.vector.data()); }
+inline float4 load(const Vector3df & v) {
+  const float padded[4] = {v.vector[0], v.vector[1], v.vector[2], 0.0f};
+  return vld1q_f32(padded);
+}
+inline void store(float4 r, Vector4df & v) { vst1q_f32(v.vector.data(), r); }
+inline void store(float4 r, float * out) { vst1q_f32(out, r); }
+inline float4 zero() { return vdupq_n_f32(0.0f); }
+inline float4 broadcast(float s) { return vdupq_n_f32(s); }
+inline float4 add(float4 a, float4 b) { return vaddq_f32(a, b); }
+inline float4 subtract(float4 a, float4 b) { return vsubq_f32(a, b); }
+inline float4 multiply(float4 a, float4 b) { return vmulq_f32(a, b); }
+inline float4 divide(float4 a, float4 b) { return vdivq_f32(a, b); }
+
+// (y, x, x, w) und (z, z, y, w) fuer das Kreuzprodukt
+inline float4 yxxw(float4 a) {
+  float4 r = vrev64q_f32(a);
+  r = vsetq_lane_f32(vgetq_lane_f32(a, 0), r, 2);
+  return vsetq_lane_f32(vgetq_lane_f32(a, 3), r, 3);
+}
+inline float4 zzyw(float4 a) {
+  float4 r = vdupq_laneq_f32(a, 2);
+  r = vsetq_lane_f32(vgetq_lane_f32(a, 1), r, 2);
+  return vsetq_lane_f32(vgetq_lane_f32(a, 3), r, 3);
+}
+
+#else
+
+typedef __m128 float4;
+
+inline float4 load(const Vector4df & v) { return _mm_load_ps(v.vector.data()); }
+inline float4 load(const Vector3df & v) { return _mm_setr_ps(v.vector[0], v.vector[1], v.vector[2], 0.0f); }
+inline void store(float4 r, Vector4df & v) { _mm_store_ps(v.vector.data(), r); }
+inline void store(float4 r, float * out) { _mm_storeu_ps(out, r); }
+inline float4 zero() { return _mm_setzero_ps(); }
+inline float4 broadcast(float s) { return _mm_set1_ps(s); }
+inline float4 add(float4 a, float4 b) { return _mm_add_ps(a, b); }
+inline float4 subtract(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+inline float4 multiply(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+inline float4 divide(float4 a, float4 b) { return _mm_div_ps(a, b); }
+
+// (y, x, x, w) und (z, z, y, w) fuer das Kreuzprodukt
+inline float4 yxxw(float4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 0, 1)); }
+inline float4 zzyw(float4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 2, 2)); }
+
+#endif
+
+inline void store(float4 r, Vector3df & v) {
+  float lanes[4];
+  store(r, lanes);
+  v.vector[0] = lanes[0];
+  v.vector[1] = lanes[1];
+  v.vector[2] = lanes[2];
+}
+
+// summiert die ersten K Lanes in der Reihenfolge der generischen Schleife
+template <size_t K>
+inline float sum(float4 r) {
+  float lanes[4];
+  store(r, lanes);
+  float result = 0;
+  for (size_t i = 0; i < K; i++) {
+    result += lanes[i];
+  }
+  return result;
+}
+
+} // namespace simd
+
+template <>
+constexpr float operator*<float, 4u>(Vector<float, 4u> vector1, const Vector<float, 4u> vector2) {
+  if (std::is_constant_evaluated()) {
+    float sum = 0;
+    for (size_t i = 0; i < 4u; i++) {
+      sum += vector1.vector[i] * vector2.vector[i];
+    }
+    return sum;
+  }
+  return simd::sum<4u>(simd::multiply(simd::load(vector1), simd::load(vector2)));
+}
+
+template <>
+constexpr float operator*<float, 3u>(Vector<float, 3u> vector1, const Vector<float, 3u> vector2) {
+  if (std::is_constant_evaluated()) {
+    float sum = 0;
+    for (size_t i = 0; i < 3u; i++) {
+      sum += vector1.vector[i] * vector2.vector[i];
+    }
+    return sum;
+  }
+  return simd::sum<3u>(simd::multiply(simd::load(vector1), simd::load(vector2)));
+}
+
+template <>
+inline void Vector<float, 4u>::normalize() {
+  const simd::float4 v = simd::load(*this);
+  const float length = std::sqrt(simd::sum<4u>(simd::multiply(v, v)));
+  simd::store(simd::divide(v, simd::broadcast(length)), *this);
+}
+
+template <>
+inline void Vector<float, 3u>::normalize() {
+  const simd::float4 v = simd::load(*this);
+  const float length = std::sqrt(simd::sum<3u>(simd::multiply(v, v)));
+  simd::store(simd::divide(v, simd::broadcast(length)), *this);
+}
+
+// gleiche Vorzeichenkonvention wie cross_product in math.tcc
+template <>
+constexpr Vector<float, 3u> Vector<float, 3u>::cross_product(const Vector<float, 3u> v) const {
+  if (std::is_constant_evaluated()) {
+    return {vector[1] * v.vector[2] - vector[2] * v.vector[1],
+            vector[0] * v.vector[2] - vector[2] * v.vector[0],
+            vector[0] * v.vector[1] - vector[1] * v.vector[0] };
+  }
+  const simd::float4 a = simd::load(*this);
+  const simd::float4 b = simd::load(v);
+  Vector<float, 3u> result;
+  simd::store(simd::subtract(simd::multiply(simd::yxxw(a), simd::zzyw(b)),
+                             simd::multiply(simd::zzyw(a), simd::yxxw(b))), result);
+  return result;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,525 @@
+#include "math.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+//eigene tests
+TEST(VECTOR, SquareOfLengthTest1) {
+  Vector3df v = {3.0, 4.0, 0.0};
+  EXPECT_NEAR(25.0, v.square_of_length(), 0.00001);
+}
+
+TEST(VECTOR, SquareOfLengthTest2) {
+  Vector2df v = {5.0, 12.0};
+  EXPECT_NEAR(169.0, v.square_of_length(), 0.00001);
+}
+
+TEST(VECTOR, LengthTest1) {
+  Vector3df v = {3.0, 4.0, 0.0};
+  EXPECT_NEAR(5.0, v.length(), 0.00001);
+}
+
+TEST(VECTOR, LengthTest2) {
+  Vector4df v = {2.0, 3.0, 6.0, 0.0};
+  EXPECT_NEAR(7.0, v.length(), 0.00001);
+}
+
+TEST(VECTOR, ScalarProductTest1) {
+  Vector2df v1 = {2.0, 3.0};
+  Vector2df v2 = {4.0, 5.0};
+  EXPECT_NEAR(23.0, v1 * v2, 0.00001);
+}
+
+TEST(VECTOR, ScalarProductTest2) {
+  Vector3df v1 = {1.0, 0.0, -1.0};
+  Vector3df v2 = {2.0, 3.0, 4.0};
+  EXPECT_NEAR(-2.0, v1 * v2, 0.00001);
+}
+//ende eigene tests
+
+
+	
+TEST(VECTOR, ListInitialization2df) {
+  Vector2df vector = {1.0, 0.0};
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+}
+
+TEST(VECTOR, ListInitialization3df) {
+  Vector3df vector = {1.0, 0.0, 5.0};
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+  EXPECT_NEAR(5.0, vector[2], 0.00001);
+}
+
+
+TEST(VECTOR, ListInitialization4df) {
+  Vector4df vector = {1.0, 0.0, 5.0, -5.0};
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+  EXPECT_NEAR(5.0, vector[2], 0.00001);
+  EXPECT_NEAR(-5.0, vector[3], 0.00001);
+}
+
+TEST(VECTOR, ListInitialization4df_2) {
+  Vector4df vector = {1.0, 2.0, 3.0, 4.0};
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(2.0, vector[1], 0.00001);
+  EXPECT_NEAR(3.0, vector[2], 0.00001);
+  EXPECT_NEAR(4.0, vector[3], 0.00001);
+}
+
+TEST(VECTOR, ListInitializationSizeToSmall) {
+  Vector4df vector = {1.0, 2.0, 3.0, };
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(2.0, vector[1], 0.00001);
+  EXPECT_NEAR(3.0, vector[2], 0.00001);
+  EXPECT_NEAR(3.0, vector[3], 0.00001);
+}
+
+TEST(VECTOR, EmptyListInitialization) {
+  Vector4df vector = {};
+  
+  EXPECT_NEAR(0.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+  EXPECT_NEAR(0.0, vector[2], 0.00001);
+  EXPECT_NEAR(0.0, vector[3], 0.00001);
+}
+
+TEST(VECTOR, UnitVectorWithAngle) {
+  Vector2df vector(0.0f);
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+}
+
+TEST(VECTOR, UnitVectorWithAngle90) {
+  Vector2df vector(PI / 2.0f);
+  
+  EXPECT_NEAR(0.0, vector[0], 0.00001);
+  EXPECT_NEAR(1.0, vector[1], 0.00001);
+}
+
+
+TEST(VECTOR, CopyConstructor) {
+  Vector2df vector = {1.0, 0.0};
+  Vector2df copy(vector);
+  EXPECT_NEAR(1.0, copy[0], 0.00001);
+  EXPECT_NEAR(0.0, copy[1], 0.00001);
+}
+
+
+TEST(VECTOR, SquareOfLength1) {
+  Vector2df vector = {2.0, 2.0};
+  
+  EXPECT_NEAR(8.0, vector.square_of_length(), 0.00001);
+}
+
+TEST(VECTOR, SquareOfLength3df) {
+  Vector3df vector = {4.0, 0.0, 3.0};
+  
+  EXPECT_NEAR(25.0, vector.square_of_length(), 0.00001);
+}
+
+TEST(VECTOR, Length) {
+  Vector2df vector = {-3.0, 4.0};
+  
+  EXPECT_NEAR(5.0, vector.length(), 0.00001);
+}
+
+TEST(VECTOR, Length3df) {
+  Vector3df vector = {0.0, -4.0, 3.0};
+  float length = vector.length();
+    
+  EXPECT_NEAR(5.0, length, 0.00001);
+}
+
+TEST(VECTOR, Normalize) {
+  Vector2df vector = {-3.0, 4.0};
+  
+  vector.normalize();
+  EXPECT_NEAR(1.0, vector.length(), 0.00001);
+}
+
+TEST(VECTOR, Normalize3df) {
+  Vector3df vector = {-3.0, 4.0, 7.8};
+  
+  vector.normalize();
+  EXPECT_NEAR(1.0, vector.length(), 0.00001);
+}
+
+TEST(VECTOR, Normalize4df) {
+  Vector4df vector = {-3.5, 7.5, 0.001, 4.0};
+  
+  vector.normalize();
+  EXPECT_NEAR(1.0, vector.length(), 0.00001);
+}
+
+TEST(VECTOR, GetReflective1) {
+  Vector2df vector = {1.0, -1.0};
+  Vector2df normal = {0.0, 1.0};
+  
+  Vector2df reflectiv = vector.get_reflective(normal);
+  
+  EXPECT_NEAR(1.0, reflectiv[0], 0.00001);
+  EXPECT_NEAR(1.0, reflectiv[1], 0.00001);
+}
+
+TEST(VECTOR, GetReflective2) {
+  Vector2df vector = {0.0, -1.0};
+  Vector2df normal = {1.0, 1.0};
+  
+  normal.normalize();
+  
+  Vector2df reflectiv = vector.get_reflective(normal);
+  
+  EXPECT_NEAR(1.0, reflectiv[0], 0.00001);
+  EXPECT_NEAR(0.0, reflectiv[1], 0.00001);
+}
+
+TEST(VECTOR, GetReflective3df_1) {
+  Vector3df vector = {0.0, 1.0, -1.0};
+  Vector3df normal = {0.0, 0.0, 1.0};
+  
+  Vector3df reflectiv = vector.get_reflective(normal);
+  
+  EXPECT_NEAR(0.0, reflectiv[0], 0.00001);
+  EXPECT_NEAR(1.0, reflectiv[1], 0.00001);
+  EXPECT_NEAR(1.0, reflectiv[2], 0.00001);
+}
+
+TEST(VECTOR, Angle90) {
+  Vector2df vector{ 0.0f, 1.0f};
+  
+  EXPECT_NEAR(PI / 2.0f, vector.angle(0,1), 0.00001);
+}
+
+TEST(VECTOR, Angle180) {
+  Vector2df vector{ -1.0f, 0.0f};
+  
+  EXPECT_NEAR(PI, vector.angle(0,1), 0.00001);
+}
+
+TEST(VECTOR, Angle270) {
+  Vector2df vector{ 0.0f, -1.0f};
+  
+  EXPECT_NEAR(-PI / 2.0f, vector.angle(0,1), 0.00001);
+}
+
+TEST(VECTOR, Angle0) {
+  Vector2df vector(0.0f);
+  
+  EXPECT_NEAR(0.0f, vector.angle(0,1), 0.00001);
+}
+
+TEST(VECTOR, SumsTwoVectors) {
+  Vector2df vector = {1.0, 0.0};
+  Vector2df addend = {-2.0, 1.0};
+  Vector2df sum = vector + addend;
+  
+  EXPECT_NEAR(1.0, vector[0], 0.00001);
+  EXPECT_NEAR(0.0, vector[1], 0.00001);
+  EXPECT_NEAR(-1.0, sum[0], 0.00001);
+  EXPECT_NEAR(1.0, sum[1], 0.00001);
+  EXPECT_NEAR(-2.0, addend[0], 0.00001);
+  EXPECT_NEAR(1.0, addend[1], 0.00001);
+}
+
+TEST(VECTOR, SumsTwoVectors3df) {
+  Vector3df vector = {0.0, 1.0, 0.0};
+  Vector3df addend = {0.0, -2.0, 1.0};
+  Vector3df sum = vector + addend;
+  
+  EXPECT_NEAR( 0.0, sum[0], 0.00001);
+  EXPECT_NEAR(-1.0, sum[1], 0.00001);
+  EXPECT_NEAR( 1.0, sum[2], 0.00001);
+}
+
+
+TEST(VECTOR, AddToVector) {
+  Vector2df vector = {0.1, 0.5};
+  Vector2df addend = {0.0, 0.5};
+  vector += addend;
+  
+  EXPECT_NEAR(0.1, vector[0], 0.00001);
+  EXPECT_NEAR(1.0, vector[1], 0.00001);
+}
+
+TEST(VECTOR, ScalarProduct) {
+  Vector2df vector1 = {1.0, 0.0};
+  Vector2df vector2 = 2.0f * vector1;
+  
+  EXPECT_NEAR(2.0, vector2[0], 0.00001);
+  EXPECT_NEAR(0.0, vector2[1], 0.00001);
+}
+
+TEST(VECTOR, ScalarProduct3df) {
+  Vector3df vector1 = {0.0, 1.0, 0.0};
+  Vector3df vector2 = 2.0f * vector1;
+  
+  EXPECT_NEAR(0.0, vector1[0], 0.00001);
+  EXPECT_NEAR(1.0, vector1[1], 0.00001);
+  EXPECT_NEAR(0.0, vector1[2], 0.00001);
+  EXPECT_NEAR(0.0, vector2[0], 0.00001);
+  EXPECT_NEAR(2.0, vector2[1], 0.00001);
+  EXPECT_NEAR(0.0, vector2[2], 0.00001);
+}
+
+
+TEST(VECTOR, ScalarAssignmentProduct) {
+  Vector2df vector1 = {1.0, 0.0};
+  vector1 *= 2.0;
+  
+  EXPECT_NEAR(2.0, vector1[0], 0.00001);
+  EXPECT_NEAR(0.0, vector1[1], 0.00001);
+}
+
+TEST(VECTOR, ScalarAssignmentDivision) {
+  Vector2df vector1 = {1.0, 0.0};
+  vector1 /= 0.5;
+  
+  EXPECT_NEAR(2.0, vector1[0], 0.00001);
+  EXPECT_NEAR(0.0, vector1[1], 0.00001);
+}
+
+TEST(VECTOR, ScalarVectorProduct1) {
+  Vector2df vector1 = {1.0, 0.0};
+  Vector2df vector2 = {0.0, 1.0};
+  
+  EXPECT_NEAR(0.0, vector1 * vector2, 0.00001);
+}
+
+TEST(VECTOR, ScalarVectorProduct2) {
+  Vector3df vector1 = {1.0, 2.0, -1.0};
+  Vector3df vector2 = {-1.0, 1.0, 3.0};
+
+  float scalar = vector1 * vector2;
+
+  EXPECT_NEAR(-2.0, scalar, 0.00001);
+  EXPECT_NEAR(1.0, vector1[0], 0.00001);
+  EXPECT_NEAR(2.0,  vector1[1], 0.00001);
+  EXPECT_NEAR(-1.0, vector1[2], 0.00001);
+  EXPECT_NEAR(-1.0, vector2[0], 0.00001);
+  EXPECT_NEAR(1.0,  vector2[1], 0.00001);
+  EXPECT_NEAR(3.0, vector2[2], 0.00001);
+}
+
+TEST(VECTOR, ScalarVectorProduct3df_1) {
+  Vector3df vector1 = {0.0, 1.0, 0.0};
+  Vector3df vector2 = {0.0, 0.0, 1.0};
+  
+  EXPECT_NEAR(0.0, vector1 * vector2, 0.00001);
+}
+
+TEST(VECTOR, ScalarVectorProduct3df_2) {
+  Vector3df vector1 = {-1.0, 2.0, 3.0};
+  Vector3df vector2 = { 2.0, 2.0, -1.0};
+  
+  EXPECT_NEAR(-1.0, vector1 * vector2, 0.00001);
+}
+
+TEST(VECTOR, ScalarVectorProduct3df_3) {
+  Vector3df vector1 = {0.0,  -2.0, 0.0};
+  Vector3df vector2 = {0.0, -10.0, 0.0};
+  
+  EXPECT_NEAR(20.0, vector1 * vector2, 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct1) {
+  Vector3df vector1 = {1.0, 0.0, 0.0};
+  Vector3df vector2 = {0.0, 1.0, 0.0};
+  Vector3df cross = vector1.cross_product(vector2);
+  
+  EXPECT_NEAR(0.0, cross[0], 0.00001);
+  EXPECT_NEAR(0.0, cross[1], 0.00001);
+  EXPECT_NEAR(1.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct2) {
+  Vector3df vector1 = {-2.0, 1.0, -2.0};
+  Vector3df vector2 = {-3.0, 3.0, 0.0};
+  Vector3df cross = vector1.cross_product(vector2);
+  
+  EXPECT_NEAR(-2.0, vector1[0], 0.00001);
+  EXPECT_NEAR(1.0,  vector1[1], 0.00001);
+  EXPECT_NEAR(-2.0, vector1[2], 0.00001);
+  EXPECT_NEAR(-3.0, vector2[0], 0.00001);
+  EXPECT_NEAR(3.0,  vector2[1], 0.00001);
+  EXPECT_NEAR(0.0, vector2[2], 0.00001);
+  EXPECT_NEAR(6.0, cross[0], 0.00001);
+  EXPECT_NEAR(-6.0,  cross[1], 0.00001);
+  EXPECT_NEAR(-3.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct3) {
+  Vector3df vector1 = {-1.0, 0.0, -4.0};
+  Vector3df vector2 = {2.0, 0.0, -2.0};
+  Vector3df cross = vector1.cross_product(vector2);
+  
+  EXPECT_NEAR(-1.0, vector1[0], 0.00001);
+  EXPECT_NEAR(0.0,  vector1[1], 0.00001);
+  EXPECT_NEAR(-4.0, vector1[2], 0.00001);
+  EXPECT_NEAR(2.0, vector2[0], 0.00001);
+  EXPECT_NEAR(0.0,  vector2[1], 0.00001);
+  EXPECT_NEAR(-2.0, vector2[2], 0.00001);
+  EXPECT_NEAR(0.0, cross[0], 0.00001);
+  EXPECT_NEAR(10.0,  cross[1], 0.00001);
+  EXPECT_NEAR(0.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct4) {
+  Vector3df vector1 = {-1.0, 0.0, -4.0};
+  Vector3df vector2 = {2.0, 0.0, -2.0};
+  
+  Vector3df cross = vector2.cross_product(vector1);
+  
+  EXPECT_NEAR(-1.0, vector1[0], 0.00001);
+  EXPECT_NEAR(0.0,  vector1[1], 0.00001);
+  EXPECT_NEAR(-4.0, vector1[2], 0.00001);
+  EXPECT_NEAR(2.0, vector2[0], 0.00001);
+  EXPECT_NEAR(0.0,  vector2[1], 0.00001);
+  EXPECT_NEAR(-2.0, vector2[2], 0.00001);
+  EXPECT_NEAR(0.0, cross[0], 0.00001);
+  EXPECT_NEAR(-10.0,  cross[1], 0.00001);
+  EXPECT_NEAR(0.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct5) {
+  Vector3df a = {-1.0, 0.0, -2.0};
+  Vector3df b = { 2.0, 0.0, 0.0};
+  Vector3df c = { 0.0, 0.0, 2.0};
+  Vector3df ab = b - a;
+  Vector3df ac = c - a;
+  
+  Vector3df cross = ab.cross_product(ac);
+
+  EXPECT_NEAR(3.0, ab[0], 0.00001);
+  EXPECT_NEAR(0.0, ab[1], 0.00001);
+  EXPECT_NEAR(2.0, ab[2], 0.00001);
+
+  EXPECT_NEAR(1.0, ac[0], 0.00001);
+  EXPECT_NEAR(0.0, ac[1], 0.00001);
+  EXPECT_NEAR(4.0, ac[2], 0.00001);
+
+  
+  EXPECT_NEAR(0.0,  cross[0], 0.00001);
+  EXPECT_NEAR(10.0, cross[1], 0.00001);
+  EXPECT_NEAR(0.0,  cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct6) {
+  Vector3df vector1 = {1.0, 0.0, 0.0};
+  Vector3df vector2 = {0.0, 0.0, 1.0};
+  Vector3df cross = vector1.cross_product(vector2);
+  
+  EXPECT_NEAR(0.0, cross[0], 0.00001);
+  EXPECT_NEAR(1.0, cross[1], 0.00001);
+  EXPECT_NEAR(0.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, CrossVectorProduct7) {
+  Vector3df vector1 = {0.0, 1.0, 0.0};
+  Vector3df vector2 = {0.0, 0.0, 1.0};
+  Vector3df cross = vector1.cross_product(vector2);
+  
+  EXPECT_NEAR(1.0, cross[0], 0.00001);
+  EXPECT_NEAR(0.0, cross[1], 0.00001);
+  EXPECT_NEAR(0.0, cross[2], 0.00001);
+}
+
+TEST(VECTOR, ConstexprEvaluation) {
+  constexpr Vector3df a = {1.0, 2.0, 3.0};
+  constexpr Vector3df b = {4.0, 5.0};
+  constexpr Vector3df sum = a + 2.0f * b;
+  constexpr Vector3df cross = a.cross_product(b);
+  constexpr float dot = a * b;
+  static_assert(sum[2] == 13.0f);
+  static_assert(cross[0] == -5.0f && cross[1] == -7.0f && cross[2] == -3.0f);
+  static_assert(dot == 29.0f);
+  static_assert(Vector4df{}[3] == 0.0f);
+
+  // zur Laufzeit (SIMD) muss dasselbe Ergebnis entstehen
+  Vector3df c = a;
+  EXPECT_EQ(cross[1], c.cross_product(b)[1]);
+  EXPECT_EQ(dot, c * b);
+}
+
+// die SIMD-Spezialisierungen (math_simd.h) muessen bitgenau mit den skalaren Schleifen uebereinstimmen
+const Vector4df simd_values[] = { {0.1f, -2.7f, 3.3f, 1e-3f},
+                                  {1e7f, 3.1f, -1e-7f, 0.5f},
+                                  {-0.3f, 0.7f, 0.9f, -4.2f},
+                                  {123.456f, -0.001f, 7.0f, 2.0f} };
+
+TEST(VECTOR, SimdScalarProductBitExact) {
+  for (const Vector4df & a : simd_values) {
+    for (const Vector4df & b : simd_values) {
+      float sum4 = 0, sum3 = 0;
+      for (size_t i = 0; i < 4; i++) {
+        sum4 += a[i] * b[i];
+        if (i < 3) sum3 = sum4;
+      }
+      EXPECT_EQ(sum4, a * b);
+      EXPECT_EQ(sum3, Vector3df({a[0], a[1], a[2]}) * Vector3df({b[0], b[1], b[2]}));
+    }
+  }
+}
+
+TEST(VECTOR, SimdNormalizeBitExact) {
+  for (const Vector4df & a : simd_values) {
+    Vector4df v4 = a;
+    Vector3df v3 = {a[0], a[1], a[2]};
+    v4.normalize();
+    v3.normalize();
+    float sum = 0;
+    for (size_t i = 0; i < 3; i++) {
+      sum += a[i] * a[i];
+    }
+    const float length3 = std::sqrt(sum);
+    const float length4 = std::sqrt(sum + a[3] * a[3]);
+    for (size_t i = 0; i < 4; i++) {
+      EXPECT_EQ(a[i] / length4, v4[i]);
+      if (i < 3) {
+        EXPECT_EQ(a[i] / length3, v3[i]);
+      }
+    }
+  }
+}
+
+TEST(VECTOR, SimdCrossProductBitExact) {
+  for (const Vector4df & a : simd_values) {
+    for (const Vector4df & b : simd_values) {
+      Vector3df cross = Vector3df({a[0], a[1], a[2]}).cross_product({b[0], b[1], b[2]});
+      EXPECT_EQ(a[1] * b[2] - a[2] * b[1], cross[0]);
+      EXPECT_EQ(a[0] * b[2] - a[2] * b[0], cross[1]);
+      EXPECT_EQ(a[0] * b[1] - a[1] * b[0], cross[2]);
+    }
+  }
+}
+
+TEST(VECTOR, DoubleInstantiation) {
+  Vector3dd a = {1.0, 2.0, 2.0};
+  EXPECT_EQ(3.0, a.length());
+  EXPECT_EQ(9.0, a * a);
+  a.normalize();
+  EXPECT_NEAR(2.0 / 3.0, a[2], 1e-15);
+  Vector3df converted(Vector3dd{0.1, 0.2, 0.3});
+  EXPECT_EQ(0.2f, converted[1]);
+}
+
+// Mischbetrieb: 10^7 Einheiten vom Ursprung entfernt hat float nur noch eine Aufloesung von 1,
+//   die Differenz in double bleibt genau
+TEST(VECTOR, RelativeToKeepsPrecisionFarFromOrigin) {
+  const Vector2dd camera = {1e7, -3e7};
+  const Vector2dd position = camera + Vector2dd{0.25, -0.75};
+  EXPECT_NE(0.25f, Vector2df(position)[0] - Vector2df(camera)[0]);
+  const Vector2df delta = relative_to(position, camera);
+  EXPECT_EQ(0.25f, delta[0]);
+  EXPECT_EQ(-0.75f, delta[1]);
+}
+
+}
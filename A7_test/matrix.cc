@@ -1,5 +1,4 @@
 #include "matrix.h"
-#include "matrix.tcc"
 
 template class SquareMatrix<float, 2u>;
 template class SquareMatrix<float, 3u>; 
@@ -9,3 +8,6 @@ template SquareMatrix<float, 2> operator*(const SquareMatrix<float, 2> factor1,
 template SquareMatrix<float, 3> operator*(const SquareMatrix<float, 3> factor1, const SquareMatrix<float,3> factor2);
 template SquareMatrix<float, 4> operator*(const SquareMatrix<float, 4> factor1, const SquareMatrix<float,4> factor2);
 
+template class Affine3<float>;
+
+template Affine3<float> operator*(const Affine3<float> factor1, const Affine3<float> factor2);
@@ -2,41 +2,415 @@
 #define MATRIX_H
 
 #include "math.h"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 
+// alle Operationen sind constexpr und daher im Header definiert,
+//   feste Transformationen koennen so zur Compile-Zeit berechnet werden
 template <class FLOAT, size_t N>
 class SquareMatrix {
   static_assert(N > 0u);
   // Werte werden spaltenweise (als Vektoren) gespeichert
   std::array< Vector<FLOAT,N>, N> matrix;
 public:
-  SquareMatrix() = default;
+  constexpr SquareMatrix() = default;
 
-  SquareMatrix(std::initializer_list< Vector<FLOAT, N > > values);
+  constexpr SquareMatrix(std::initializer_list< Vector<FLOAT, N > > values);
     
   // Gibt eine Referenz auf den i-ten Spaltenvektor zurück
-  Vector<FLOAT, N> & operator[](std::size_t i);
+  constexpr Vector<FLOAT, N> & operator[](std::size_t i);
 
   // Gibt den i-ten Spaltenvektor zurück
-  Vector<FLOAT, N> operator[](std::size_t i) const;
+  constexpr Vector<FLOAT, N> operator[](std::size_t i) const;
   
   // Gibt den Wert an der angegebenen Zeile und Spalte zurück
-  FLOAT at(size_t row, size_t column) const;
+  constexpr FLOAT at(size_t row, size_t column) const;
 
   // Gibt eine Referenz auf den Wert an der angegebenen Zeile und Spalte zurück
-  FLOAT & at(size_t row, size_t column);
+  constexpr FLOAT & at(size_t row, size_t column);
   
   // Gibt das Produkt dieser SquareMatrix mit dem angegebenen Vektor zurück
-  Vector<FLOAT,N> operator*(const Vector<FLOAT,N> vector) const;
+  constexpr Vector<FLOAT,N> operator*(const Vector<FLOAT,N> vector) const;
 
   // Gibt das Produkt von zwei quadratischen Matrizen zurück
   template <class F, size_t K>
-  friend SquareMatrix<F, K> operator*(const SquareMatrix<F, K> factor1, const SquareMatrix<F, K> factor2);
+  friend constexpr SquareMatrix<F, K> operator*(const SquareMatrix<F, K> factor1, const SquareMatrix<F, K> factor2);
 
+  // Gibt die Einheitsmatrix zurück
+  static constexpr SquareMatrix identity();
+
+  // Gibt die transponierte Matrix zurück
+  constexpr SquareMatrix transpose() const;
+
+  // Gibt die Determinante zurück
+  constexpr FLOAT determinant() const;
+
+  // Gibt die inverse Matrix zurück
+  // wirft std::domain_error, wenn die Matrix singulär ist
+  constexpr SquareMatrix inverse() const;
+
+  // Gibt die inverse Matrix einer affinen Transformation zurück (letzte Zeile 0, ..., 0, 1)
+  // braucht nur die Inverse des linearen Teils, wirft std::domain_error, wenn dieser singulär ist
+  constexpr SquareMatrix affine_inverse() const requires (N > 1u);
+
+  // Gibt die Normalenmatrix zurück: die Inverse der Transponierten des linearen Teils
+  //   (obere linke (N-1)x(N-1)-Matrix), damit bleiben Normalen auch bei ungleichmäßiger
+  //   Skalierung senkrecht auf den Flächen
+  // wirft std::domain_error, wenn der lineare Teil singulär ist
+  constexpr SquareMatrix<FLOAT, N - 1> normal_matrix() const requires (N > 1u);
+
+  // wie normal_matrix(), aber ohne Ausnahme: std::nullopt, wenn der lineare Teil fast singulär ist,
+  //   d.h. |det| <= epsilon * (längste Spalte)^(N - 1), oder wenn 1/det nicht mehr darstellbar ist
+  // eine gleichmäßig kleine Skalierung ist damit nicht singulär, ein flach gedrücktes Objekt schon
+  constexpr std::optional<SquareMatrix<FLOAT, N - 1>> try_normal_matrix(FLOAT epsilon = static_cast<FLOAT>(1e-6)) const
+    requires (N > 1u);
+};
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N>::SquareMatrix(std::initializer_list< Vector<FLOAT, N > > values) {
+  auto iterator = values.begin();
+  for (size_t i = 0u; i < N; i++) {
+    if (iterator != values.end()) {
+      matrix[i] = *iterator++;
+    } else {
+        matrix[i] = Vector<FLOAT, N>({static_cast<FLOAT>(0.0)});
+    }
+  }
+}
+
+template <class FLOAT, size_t N>
+constexpr Vector<FLOAT, N> & SquareMatrix<FLOAT, N>::operator[](std::size_t i) {
+  return matrix[i];
+}
+
+template <class FLOAT, size_t N>
+constexpr Vector<FLOAT, N> SquareMatrix<FLOAT, N>::operator[](std::size_t i) const {
+  return matrix[i];
+}
+
+template <class FLOAT, size_t N>
+constexpr FLOAT SquareMatrix<FLOAT, N>::at(size_t row, size_t column) const {
+  return matrix[column][row];
+}
+
+template <class FLOAT, size_t N>
+constexpr FLOAT & SquareMatrix<FLOAT, N>::at(size_t row, size_t column) {
+  return matrix[column][row];
+}
+
+//linearkombination
+template <class FLOAT, size_t N>
+constexpr Vector<FLOAT,N> SquareMatrix<FLOAT, N>::operator*(const Vector<FLOAT,N> vector) const {
+  Vector<FLOAT, N> result({static_cast<FLOAT>(0.0)}); 
+  for (size_t col = 0; col < N; ++col) {
+      result += vector[col] * matrix[col];
+  }
+  return result;
+}
+
+template <class F, size_t K>
+constexpr SquareMatrix<F, K> operator*(const SquareMatrix<F, K> factor1, const SquareMatrix<F, K> factor2) {
+  SquareMatrix<F, K> result;
+  for (size_t col = 0; col < K; ++col) {
+      //Matrix 1 wird mit jeder Spalte aus Matrix2
+      result[col] = factor1 * factor2[col];
+  }
+  return result;
+}
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N> SquareMatrix<FLOAT, N>::identity() {
+  SquareMatrix<FLOAT, N> result;
+  for (size_t i = 0; i < N; ++i) {
+    result.at(i, i) = 1.0;
+  }
+  return result;
+}
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N> SquareMatrix<FLOAT, N>::transpose() const {
+  SquareMatrix<FLOAT, N> result;
+  for (size_t col = 0; col < N; ++col) {
+    for (size_t row = 0; row < N; ++row) {
+      result.at(row, col) = at(col, row);
+    }
+  }
+  return result;
+}
+
+// Gauss-Elimination mit Spaltenpivotsuche, tauscht in left und right dieselben Zeilen
+//   und formt left in die Einheitsmatrix um, right enthält danach left^-1 * right
+// gibt das Produkt der Pivotelemente (mit Vorzeichen der Vertauschungen) zurück, 0 wenn left singulär ist
+template <class FLOAT, size_t N>
+constexpr FLOAT gauss_jordan(SquareMatrix<FLOAT, N> & left, SquareMatrix<FLOAT, N> & right) {
+  FLOAT determinant = 1;
+  for (size_t col = 0; col < N; ++col) {
+    size_t pivot = col;
+    for (size_t row = col + 1; row < N; ++row) {
+      FLOAT candidate = left.at(row, col) < 0 ? -left.at(row, col) : left.at(row, col);
+      FLOAT current = left.at(pivot, col) < 0 ? -left.at(pivot, col) : left.at(pivot, col);
+      if (candidate > current) {
+        pivot = row;
+      }
+    }
+    if (left.at(pivot, col) == 0) {
+      return 0;
+    }
+    if (pivot != col) {
+      for (size_t k = 0; k < N; ++k) {
+        std::swap(left.at(pivot, k), left.at(col, k));
+        std::swap(right.at(pivot, k), right.at(col, k));
+      }
+      determinant = -determinant;
+    }
+    determinant *= left.at(col, col);
+    FLOAT factor = 1 / left.at(col, col);
+    for (size_t k = 0; k < N; ++k) {
+      left.at(col, k) *= factor;
+      right.at(col, k) *= factor;
+    }
+    for (size_t row = 0; row < N; ++row) {
+      FLOAT scale = left.at(row, col);
+      if (row != col && scale != 0) {
+        for (size_t k = 0; k < N; ++k) {
+          left.at(row, k) -= scale * left.at(col, k);
+          right.at(row, k) -= scale * right.at(col, k);
+        }
+      }
+    }
+  }
+  return determinant;
+}
+
+template <class FLOAT, size_t N>
+constexpr FLOAT SquareMatrix<FLOAT, N>::determinant() const {
+  SquareMatrix<FLOAT, N> left = *this;
+  SquareMatrix<FLOAT, N> right;
+  return gauss_jordan(left, right);
+}
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N> SquareMatrix<FLOAT, N>::inverse() const {
+  SquareMatrix<FLOAT, N> left = *this;
+  SquareMatrix<FLOAT, N> result = identity();
+  if (gauss_jordan(left, result) == 0) {
+    throw std::domain_error("SquareMatrix::inverse(): matrix is singular");
+  }
+  return result;
+}
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N> SquareMatrix<FLOAT, N>::affine_inverse() const requires (N > 1u) {
+  assert(at(N - 1, N - 1) == 1);
+  // linearer Teil: (A^-T)^T = A^-1, Verschiebung: -A^-1 * t
+  SquareMatrix<FLOAT, N - 1> linear_inverse = normal_matrix().transpose();
+  SquareMatrix<FLOAT, N> result = identity();
+  for (size_t row = 0; row < N - 1; ++row) {
+    FLOAT translation = 0;
+    for (size_t col = 0; col < N - 1; ++col) {
+      result.at(row, col) = linear_inverse.at(row, col);
+      translation += linear_inverse.at(row, col) * at(col, N - 1);
+    }
+    result.at(row, N - 1) = -translation;
+  }
+  return result;
+}
+
+template <class FLOAT, size_t N>
+constexpr SquareMatrix<FLOAT, N - 1> SquareMatrix<FLOAT, N>::normal_matrix() const requires (N > 1u) {
+  SquareMatrix<FLOAT, N - 1> linear;
+  for (size_t col = 0; col < N - 1; ++col) {
+    for (size_t row = 0; row < N - 1; ++row) {
+      linear.at(row, col) = at(row, col);
+    }
+  }
+  return linear.inverse().transpose();
+}
+
+// true, wenn eine M x M-Matrix mit der Determinante det und der größten quadrierten Spaltenlänge
+//   max_squared_length für try_normal_matrix() regulär genug ist
+template <class FLOAT, size_t M>
+constexpr bool is_well_conditioned(FLOAT det, FLOAT max_squared_length, FLOAT epsilon) {
+  FLOAT bound = epsilon * epsilon;
+  for (size_t i = 1; i < M; ++i) {
+    bound *= max_squared_length;
+  }
+  return det * det > bound && (det < 0 ? -det : det) >= std::numeric_limits<FLOAT>::min();
+}
+
+template <class FLOAT, size_t N>
+constexpr std::optional<SquareMatrix<FLOAT, N - 1>> SquareMatrix<FLOAT, N>::try_normal_matrix(FLOAT epsilon) const
+  requires (N > 1u) {
+  SquareMatrix<FLOAT, N - 1> linear;
+  FLOAT max_squared_length = 0;
+  for (size_t col = 0; col < N - 1; ++col) {
+    FLOAT squared_length = 0;
+    for (size_t row = 0; row < N - 1; ++row) {
+      linear.at(row, col) = at(row, col);
+      squared_length += at(row, col) * at(row, col);
+    }
+    max_squared_length = std::max(max_squared_length, squared_length);
+  }
+  SquareMatrix<FLOAT, N - 1> inverse = SquareMatrix<FLOAT, N - 1>::identity();
+  const FLOAT det = gauss_jordan(linear, inverse);
+  if (!is_well_conditioned<FLOAT, N - 1>(det, max_squared_length, epsilon)) {
+    return std::nullopt;
+  }
+  return inverse.transpose();
+}
+
+
+// affine Transformation im Raum: lineare 3x3-Abbildung und Verschiebung (3x4-Form)
+// entspricht einer 4x4-Matrix mit letzter Zeile (0, 0, 0, 1), das Produkt zweier
+//   affiner Transformationen braucht aber nur ein 3x3-Produkt und ein Matrix-Vektor-Produkt
+template <class FLOAT>
+class Affine3 {
+  SquareMatrix<FLOAT, 3> linear;
+  Vector<FLOAT, 3> translation;
+public:
+  // erstellt die Identitaet
+  constexpr Affine3();
+
+  constexpr Affine3(const SquareMatrix<FLOAT, 3> linear, const Vector<FLOAT, 3> translation);
+
+  // uebernimmt die ersten drei Zeilen einer 4x4-Matrix, die letzte Zeile muss (0, 0, 0, 1) sein
+  constexpr explicit Affine3(const SquareMatrix<FLOAT, 4> matrix);
+
+  // Verschiebung um position, Drehung um die z-Achse und gleichmaessige Skalierung in einem Schritt
+  // entspricht translation * rotation * scaling, cos_angle und sin_angle gehoeren zum Drehwinkel
+  static constexpr Affine3 from_trs(const Vector<FLOAT, 3> position, FLOAT cos_angle, FLOAT sin_angle, FLOAT scale);
+
+  // wie oben, der Drehwinkel wird in Radiant angegeben
+  static Affine3 from_trs(const Vector<FLOAT, 3> position, FLOAT angle, FLOAT scale);
+
+  // transformiert den Punkt point (mit Verschiebung)
+  constexpr Vector<FLOAT, 3> operator*(const Vector<FLOAT, 3> point) const;
+
+  // Gibt die zugehoerige 4x4-Matrix zurück
+  constexpr SquareMatrix<FLOAT, 4> to_matrix() const;
+
+  // Gibt die Hintereinanderausfuehrung zurück, zuerst factor2, dann factor1
+  template <class F>
+  friend constexpr Affine3<F> operator*(const Affine3<F> factor1, const Affine3<F> factor2);
 };
 
+// die Methoden setzen die Komponenten direkt statt ueber initializer_lists,
+//   da sie fuer jedes Objekt in jedem Frame aufgerufen werden
+
+template <class FLOAT>
+constexpr Affine3<FLOAT>::Affine3() {
+  for (size_t col = 0; col < 3; ++col) {
+    linear.at(col, col) = 1.0;
+  }
+}
+
+template <class FLOAT>
+constexpr Affine3<FLOAT>::Affine3(const SquareMatrix<FLOAT, 3> linear, const Vector<FLOAT, 3> translation)
+  : linear(linear), translation(translation) {
+}
+
+template <class FLOAT>
+constexpr Affine3<FLOAT>::Affine3(const SquareMatrix<FLOAT, 4> matrix) {
+  assert(matrix.at(3, 0) == 0.0 && matrix.at(3, 1) == 0.0 && matrix.at(3, 2) == 0.0 && matrix.at(3, 3) == 1.0);
+  for (size_t col = 0; col < 3; ++col) {
+    for (size_t row = 0; row < 3; ++row) {
+      linear.at(row, col) = matrix.at(row, col);
+    }
+    translation[col] = matrix.at(col, 3);
+  }
+}
+
+template <class FLOAT>
+constexpr Affine3<FLOAT> Affine3<FLOAT>::from_trs(const Vector<FLOAT, 3> position, FLOAT cos_angle, FLOAT sin_angle, FLOAT scale) {
+  Affine3<FLOAT> result;
+  result.linear.at(0, 0) = cos_angle * scale;
+  result.linear.at(1, 0) = sin_angle * scale;
+  result.linear.at(0, 1) = -sin_angle * scale;
+  result.linear.at(1, 1) = cos_angle * scale;
+  result.linear.at(2, 2) = scale;
+  result.translation = position;
+  return result;
+}
+
+template <class FLOAT>
+Affine3<FLOAT> Affine3<FLOAT>::from_trs(const Vector<FLOAT, 3> position, FLOAT angle, FLOAT scale) {
+  return from_trs(position, std::cos(angle), std::sin(angle), scale);
+}
+
+template <class FLOAT>
+constexpr Vector<FLOAT, 3> Affine3<FLOAT>::operator*(const Vector<FLOAT, 3> point) const {
+  Vector<FLOAT, 3> result = translation;
+  for (size_t row = 0; row < 3; ++row) {
+    // gleiche Summationsreihenfolge wie linear * point + translation
+    FLOAT sum = 0;
+    for (size_t col = 0; col < 3; ++col) {
+      sum += point[col] * linear.at(row, col);
+    }
+    result[row] += sum;
+  }
+  return result;
+}
+
+template <class FLOAT>
+constexpr SquareMatrix<FLOAT, 4> Affine3<FLOAT>::to_matrix() const {
+  SquareMatrix<FLOAT, 4> result;
+  for (size_t col = 0; col < 3; ++col) {
+    for (size_t row = 0; row < 3; ++row) {
+      result.at(row, col) = linear.at(row, col);
+    }
+    result.at(col, 3) = translation[col];
+  }
+  result.at(3, 3) = 1.0;
+  return result;
+}
+
+template <class F>
+constexpr Affine3<F> operator*(const Affine3<F> factor1, const Affine3<F> factor2) {
+  Affine3<F> result;
+  for (size_t col = 0; col < 3; ++col) {
+    for (size_t row = 0; row < 3; ++row) {
+      F sum = 0;
+      for (size_t k = 0; k < 3; ++k) {
+        sum += factor2.linear.at(k, col) * factor1.linear.at(row, k);
+      }
+      result.linear.at(row, col) = sum;
+    }
+  }
+  result.translation = factor1 * factor2.translation;
+  return result;
+}
+
 
 typedef SquareMatrix<float, 2u> SquareMatrix2df;
 typedef SquareMatrix<float, 3u> SquareMatrix3df;
 typedef SquareMatrix<float, 4u> SquareMatrix4df;
 
+typedef Affine3<float> Affine3df;
+
+typedef SquareMatrix<double, 2u> SquareMatrix2dd;
+typedef SquareMatrix<double, 3u> SquareMatrix3dd;
+typedef SquareMatrix<double, 4u> SquareMatrix4dd;
+
+typedef Affine3<double> Affine3dd;
+
+#include "matrix_simd.h"
+
+// die float-Instanziierungen sind vorkompiliert in matrix.cc, wie bei Vector erst nach den
+//   Spezialisierungen in matrix_simd.h; double wird nur von Tests und Benchmarks verwendet und
+//   dort implizit instanziiert (nur die verwendeten Funktionen)
+extern template class SquareMatrix<float, 2u>;
+extern template class SquareMatrix<float, 3u>;
+extern template class SquareMatrix<float, 4u>;
+
+extern template SquareMatrix<float, 2> operator*(const SquareMatrix<float, 2> factor1, const SquareMatrix<float,2> factor2);
+extern template SquareMatrix<float, 3> operator*(const SquareMatrix<float, 3> factor1, const SquareMatrix<float,3> factor2);
+extern template SquareMatrix<float, 4> operator*(const SquareMatrix<float, 4> factor1, const SquareMatrix<float,4> factor2);
+
+extern template class Affine3<float>;
+
+extern template Affine3<float> operator*(const Affine3<float> factor1, const Affine3<float> factor2);
+
 #endif
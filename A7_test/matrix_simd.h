@@ -0,0 +1,278 @@
+#ifndef MATRIX_SIMD_H
+#define MATRIX_SIMD_H
+
+// SIMD-Spezialisierungen fuer SquareMatrix4df (siehe math_simd.h)
+// Die Spalten werden wie in matrix.h der Reihe nach aufsummiert, die Ergebnisse
+//   sind daher bitgenau gleich zu den generischen Templates.
+// Zur Compile-Zeit wird die skalare Linearkombination verwendet.
+
+#include "matrix.h"
+
+#if defined(MATH_SIMD)
+
+namespace simd {
+
+// Linearkombination der Spalten mit den Komponenten von vector
+inline float4 linear_combination(const std::array<Vector4df, 4u> & columns, const float4 c0, const float4 c1,
+                                 const float4 c2, const float4 c3) {
+  float4 result = zero();
+  result = add(result, multiply(c0, load(columns[0])));
+  result = add(result, multiply(c1, load(columns[1])));
+  result = add(result, multiply(c2, load(columns[2])));
+  result = add(result, multiply(c3, load(columns[3])));
+  return result;
+}
+
+inline float4 linear_combination(const std::array<Vector4df, 4u> & columns, const Vector4df & vector) {
+  return linear_combination(columns, broadcast(vector.vector[0]), broadcast(vector.vector[1]),
+                            broadcast(vector.vector[2]), broadcast(vector.vector[3]));
+}
+
+} // namespace simd
+
+template <>
+constexpr Vector<float, 4u> SquareMatrix<float, 4u>::operator*(const Vector<float, 4u> vector) const {
+  Vector<float, 4u> result;
+  if (std::is_constant_evaluated()) {
+    for (size_t col = 0; col < 4u; ++col) {
+      result += vector[col] * matrix[col];
+    }
+    return result;
+  }
+  simd::store(simd::linear_combination(matrix, vector), result);
+  return result;
+}
+
+template <>
+constexpr SquareMatrix<float, 4u> operator*<float, 4u>(const SquareMatrix<float, 4u> factor1,
+                                                      const SquareMatrix<float, 4u> factor2) {
+  SquareMatrix<float, 4u> result;
+  if (std::is_constant_evaluated()) {
+    for (size_t col = 0; col < 4u; ++col) {
+      result.matrix[col] = factor1 * factor2.matrix[col];
+    }
+    return result;
+  }
+  for (size_t col = 0; col < 4u; ++col) {
+    simd::store(simd::linear_combination(factor1.matrix, factor2.matrix[col]), result.matrix[col]);
+  }
+  return result;
+}
+
+// Hintereinanderausfuehrung affiner Transformationen: Spalten wie oben als Linearkombination,
+//   die Verschiebung wird wie in Affine3::operator*(Vector) zum Schluss addiert
+template <>
+constexpr Affine3<float> operator*<float>(const Affine3<float> factor1, const Affine3<float> factor2) {
+  Affine3<float> result;
+  if (std::is_constant_evaluated()) {
+    for (size_t col = 0; col < 3u; ++col) {
+      result.linear[col] = factor1.linear * factor2.linear[col];
+    }
+    result.translation = factor1 * factor2.translation;
+    return result;
+  }
+  const simd::float4 c0 = simd::load(factor1.linear[0]);
+  const simd::float4 c1 = simd::load(factor1.linear[1]);
+  const simd::float4 c2 = simd::load(factor1.linear[2]);
+  for (size_t col = 0; col < 4u; ++col) {
+    const Vector3df v = col < 3u ? factor2.linear[col] : factor2.translation;
+    simd::float4 r = simd::zero();
+    r = simd::add(r, simd::multiply(c0, simd::broadcast(v.vector[0])));
+    r = simd::add(r, simd::multiply(c1, simd::broadcast(v.vector[1])));
+    r = simd::add(r, simd::multiply(c2, simd::broadcast(v.vector[2])));
+    if (col < 3u) {
+      simd::store(r, result.linear[col]);
+    } else {
+      simd::store(simd::add(simd::load(factor1.translation), r), result.translation);
+    }
+  }
+  return result;
+}
+
+#if !defined(__aarch64__)
+
+namespace simd {
+
+// Mischungen fuer die Inverse (nur SSE)
+template <int x, int y, int z, int w>
+inline float4 swizzle(float4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(w, z, y, x)); }
+template <int x, int y, int z, int w>
+inline float4 shuffle(float4 a, float4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+
+// 2x2-Matrizen (a b c d) in einem Register: A * B, adj(A) * B und A * adj(B)
+inline float4 mat2_multiply(float4 a, float4 b) {
+  return add(multiply(a, swizzle<0, 3, 0, 3>(b)), multiply(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+inline float4 mat2_adj_multiply(float4 a, float4 b) {
+  return subtract(multiply(swizzle<3, 3, 0, 0>(a), b), multiply(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+inline float4 mat2_multiply_adj(float4 a, float4 b) {
+  return subtract(multiply(a, swizzle<3, 0, 3, 0>(b)), multiply(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+// Kreuzprodukt mit der ueblichen Vorzeichenkonvention (nicht die von Vector::cross_product)
+inline float4 cross(float4 a, float4 b) {
+  return subtract(multiply(swizzle<1, 2, 0, 3>(a), swizzle<2, 0, 1, 3>(b)),
+                  multiply(swizzle<2, 0, 1, 3>(a), swizzle<1, 2, 0, 3>(b)));
+}
+
+} // namespace simd
+
+// Inverse ueber 2x2-Bloecke: M = (A B; C D), die Determinante ergibt sich aus
+//   |A||D| + |B||C| - spur(adj(A) B adj(D) C)
+// Da (M^T)^-1 = (M^-1)^T ist, kann die Rechnung direkt auf den Spalten erfolgen.
+// Rundet anders als gauss_jordan, die Ergebnisse sind daher nicht bitgenau gleich.
+template <>
+constexpr SquareMatrix<float, 4u> SquareMatrix<float, 4u>::inverse() const {
+  if (std::is_constant_evaluated()) {
+    SquareMatrix<float, 4u> left = *this;
+    SquareMatrix<float, 4u> result = identity();
+    if (gauss_jordan(left, result) == 0) {
+      throw std::domain_error("SquareMatrix::inverse(): matrix is singular");
+    }
+    return result;
+  }
+  const simd::float4 m0 = simd::load(matrix[0]);
+  const simd::float4 m1 = simd::load(matrix[1]);
+  const simd::float4 m2 = simd::load(matrix[2]);
+  const simd::float4 m3 = simd::load(matrix[3]);
+
+  const simd::float4 a = _mm_movelh_ps(m0, m1);
+  const simd::float4 b = _mm_movehl_ps(m1, m0);
+  const simd::float4 c = _mm_movelh_ps(m2, m3);
+  const simd::float4 d = _mm_movehl_ps(m3, m2);
+
+  // (|A| |B| |C| |D|)
+  const simd::float4 det_sub = simd::subtract(
+      simd::multiply(simd::shuffle<0, 2, 0, 2>(m0, m2), simd::shuffle<1, 3, 1, 3>(m1, m3)),
+      simd::multiply(simd::shuffle<1, 3, 1, 3>(m0, m2), simd::shuffle<0, 2, 0, 2>(m1, m3)));
+  const simd::float4 det_a = simd::swizzle<0, 0, 0, 0>(det_sub);
+  const simd::float4 det_b = simd::swizzle<1, 1, 1, 1>(det_sub);
+  const simd::float4 det_c = simd::swizzle<2, 2, 2, 2>(det_sub);
+  const simd::float4 det_d = simd::swizzle<3, 3, 3, 3>(det_sub);
+
+  const simd::float4 d_c = simd::mat2_adj_multiply(d, c);
+  const simd::float4 a_b = simd::mat2_adj_multiply(a, b);
+  simd::float4 x = simd::subtract(simd::multiply(det_d, a), simd::mat2_multiply(b, d_c));
+  simd::float4 w = simd::subtract(simd::multiply(det_a, d), simd::mat2_multiply(c, a_b));
+  simd::float4 y = simd::subtract(simd::multiply(det_b, c), simd::mat2_multiply_adj(d, a_b));
+  simd::float4 z = simd::subtract(simd::multiply(det_c, b), simd::mat2_multiply_adj(a, d_c));
+
+  simd::float4 trace = simd::multiply(a_b, simd::swizzle<0, 2, 1, 3>(d_c));
+  trace = simd::add(trace, simd::swizzle<1, 0, 3, 2>(trace));
+  trace = simd::add(trace, simd::swizzle<2, 3, 0, 1>(trace));
+  const simd::float4 det = simd::subtract(simd::add(simd::multiply(det_a, det_d), simd::multiply(det_b, det_c)),
+                                          trace);
+  if (_mm_cvtss_f32(det) == 0.0f) {
+    throw std::domain_error("SquareMatrix::inverse(): matrix is singular");
+  }
+  const simd::float4 factor = simd::divide(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+  x = simd::multiply(x, factor);
+  y = simd::multiply(y, factor);
+  z = simd::multiply(z, factor);
+  w = simd::multiply(w, factor);
+
+  SquareMatrix<float, 4u> result;
+  simd::store(simd::shuffle<3, 1, 3, 1>(x, y), result.matrix[0]);
+  simd::store(simd::shuffle<2, 0, 2, 0>(x, y), result.matrix[1]);
+  simd::store(simd::shuffle<3, 1, 3, 1>(z, w), result.matrix[2]);
+  simd::store(simd::shuffle<2, 0, 2, 0>(z, w), result.matrix[3]);
+  return result;
+}
+
+// Spalten der Normalenmatrix: (c1 x c2, c2 x c0, c0 x c1) / det
+template <>
+constexpr SquareMatrix<float, 3u> SquareMatrix<float, 4u>::normal_matrix() const {
+  if (std::is_constant_evaluated()) {
+    SquareMatrix<float, 3u> linear;
+    for (size_t col = 0; col < 3u; ++col) {
+      for (size_t row = 0; row < 3u; ++row) {
+        linear.at(row, col) = at(row, col);
+      }
+    }
+    return linear.inverse().transpose();
+  }
+  const simd::float4 c0 = simd::load(matrix[0]);
+  const simd::float4 c1 = simd::load(matrix[1]);
+  const simd::float4 c2 = simd::load(matrix[2]);
+  const simd::float4 n0 = simd::cross(c1, c2);
+  const float det = simd::sum<3u>(simd::multiply(c0, n0));
+  if (det == 0.0f) {
+    throw std::domain_error("SquareMatrix::normal_matrix(): matrix is singular");
+  }
+  const simd::float4 factor = simd::broadcast(1.0f / det);
+  SquareMatrix<float, 3u> result;
+  simd::store(simd::multiply(n0, factor), result[0]);
+  simd::store(simd::multiply(simd::cross(c2, c0), factor), result[1]);
+  simd::store(simd::multiply(simd::cross(c0, c1), factor), result[2]);
+  return result;
+}
+
+// wie normal_matrix(), die Spaltenlängen kommen aus denselben Registern
+template <>
+constexpr std::optional<SquareMatrix<float, 3u>> SquareMatrix<float, 4u>::try_normal_matrix(float epsilon) const {
+  if (std::is_constant_evaluated()) {
+    SquareMatrix<float, 3u> linear;
+    float max_squared_length = 0.0f;
+    for (size_t col = 0; col < 3u; ++col) {
+      float squared_length = 0.0f;
+      for (size_t row = 0; row < 3u; ++row) {
+        linear.at(row, col) = at(row, col);
+        squared_length += at(row, col) * at(row, col);
+      }
+      max_squared_length = std::max(max_squared_length, squared_length);
+    }
+    SquareMatrix<float, 3u> inverse = SquareMatrix<float, 3u>::identity();
+    const float det = gauss_jordan(linear, inverse);
+    if (!is_well_conditioned<float, 3u>(det, max_squared_length, epsilon)) {
+      return std::nullopt;
+    }
+    return inverse.transpose();
+  }
+  const simd::float4 c0 = simd::load(matrix[0]);
+  const simd::float4 c1 = simd::load(matrix[1]);
+  const simd::float4 c2 = simd::load(matrix[2]);
+  const simd::float4 n0 = simd::cross(c1, c2);
+  const float det = simd::sum<3u>(simd::multiply(c0, n0));
+  const float max_squared_length = std::max({simd::sum<3u>(simd::multiply(c0, c0)), simd::sum<3u>(simd::multiply(c1, c1)),
+                                             simd::sum<3u>(simd::multiply(c2, c2))});
+  if (!is_well_conditioned<float, 3u>(det, max_squared_length, epsilon)) {
+    return std::nullopt;
+  }
+  const simd::float4 factor = simd::broadcast(1.0f / det);
+  SquareMatrix<float, 3u> result;
+  simd::store(simd::multiply(n0, factor), result[0]);
+  simd::store(simd::multiply(simd::cross(c2, c0), factor), result[1]);
+  simd::store(simd::multiply(simd::cross(c0, c1), factor), result[2]);
+  return result;
+}
+
+// Transponieren mit vier Mischoperationen statt 16 Einzelzugriffen
+template <>
+constexpr SquareMatrix<float, 4u> SquareMatrix<float, 4u>::transpose() const {
+  SquareMatrix<float, 4u> result;
+  if (std::is_constant_evaluated()) {
+    for (size_t col = 0; col < 4u; ++col) {
+      for (size_t row = 0; row < 4u; ++row) {
+        result.at(row, col) = at(col, row);
+      }
+    }
+    return result;
+  }
+  simd::float4 c0 = simd::load(matrix[0]);
+  simd::float4 c1 = simd::load(matrix[1]);
+  simd::float4 c2 = simd::load(matrix[2]);
+  simd::float4 c3 = simd::load(matrix[3]);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  simd::store(c0, result.matrix[0]);
+  simd::store(c1, result.matrix[1]);
+  simd::store(c2, result.matrix[2]);
+  simd::store(c3, result.matrix[3]);
+  return result;
+}
+
+#endif
+
+#endif
+
+#endif
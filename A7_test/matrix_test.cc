@@ -0,0 +1,378 @@
+#include "matrix.h"
+#include "gtest/gtest.h"
+
+namespace {
+	
+TEST(MATRIX, ListInitialization2df) {
+  SquareMatrix2df matrix = { Vector2df{1.0, 0.0},
+                             Vector2df{0.0, 1.0} };
+  
+  EXPECT_NEAR(1.0, matrix.at(0,0), 0.00001);
+  EXPECT_NEAR(0.0, matrix.at(0,1), 0.00001);
+  EXPECT_NEAR(0.0, matrix.at(1,0), 0.00001);
+  EXPECT_NEAR(1.0, matrix.at(1,1), 0.00001);
+}
+
+TEST(MATRIX, ListInitialization3df) {
+  SquareMatrix3df matrix = { Vector3df{1.0, 0.0, 0.0},
+                             Vector3df{0.0, 1.0, 0.0},
+                             Vector3df{0.0, 0.0, 1.0} };
+                               
+  EXPECT_NEAR(1.0, matrix[0][0], 0.00001);
+  EXPECT_NEAR(0.0, matrix[0][1], 0.00001);
+  EXPECT_NEAR(0.0, matrix[0][2], 0.00001);
+  EXPECT_NEAR(0.0, matrix[1][0], 0.00001);
+  EXPECT_NEAR(1.0, matrix[1][1], 0.00001);
+  EXPECT_NEAR(0.0, matrix[1][2], 0.00001);
+  EXPECT_NEAR(0.0, matrix[2][0], 0.00001);
+  EXPECT_NEAR(0.0, matrix[2][1], 0.00001);
+  EXPECT_NEAR(1.0, matrix[2][2], 0.00001);
+}
+
+TEST(MATRIX, ListInitialization4df) {
+  SquareMatrix4df matrix = { {1.0, 5.0, 9.0, 13.0},
+                             {2.0, 6.0, 10.0, 14.0},
+                             {3.0, 7.0, 11.0, 15.0},
+                             {4.0, 8.0, 12.0, 16.0} };
+  
+  float v = 1.0f;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0;  column < 4; column++) {    
+      EXPECT_NEAR(v++, matrix.at(row, column), 0.00001);
+    }
+  }
+}
+
+
+
+TEST(MATRIX, ProductWithVector3df) {
+  SquareMatrix3df matrix = { {1.0, 0.0, 1.0},
+                             {0.0, 1.0, 1.0},
+                             {0.0, 0.0, 1.0} };
+  Vector3df vector = {-6.0, 3.0,  1.0};
+  Vector3df product = matrix * vector;  
+  
+  EXPECT_NEAR(-6.0, product[0], 0.00001);
+  EXPECT_NEAR( 3.0, product[1], 0.00001);
+  EXPECT_NEAR(-2.0, product[2], 0.00001);
+}
+
+
+
+TEST(MATRIX, ProductWithMatrix2df) {
+  SquareMatrix3df matrix1 = { {1.0, 2.0},
+                              {-1.0, 1.5} };
+  SquareMatrix3df matrix2 = { {2.0, -1.0},
+                              {1.0, 0.0} };
+  SquareMatrix3df matrix = matrix1 * matrix2; 
+  
+  EXPECT_NEAR( 3.0, matrix.at(0,0), 0.00001);
+  EXPECT_NEAR( 1.0, matrix.at(0,1), 0.00001);
+  EXPECT_NEAR( 2.5, matrix.at(1,0), 0.00001);
+  EXPECT_NEAR( 2.0, matrix.at(1,1), 0.00001);
+}
+
+TEST(MATRIX, ConstexprEvaluation) {
+  constexpr SquareMatrix4df rotation = { {0.0f, -1.0f, 0.0f, 0.0f},
+                                         {1.0f,  0.0f, 0.0f, 0.0f},
+                                         {0.0f,  0.0f, 1.0f, 0.0f},
+                                         {0.0f,  0.0f, 0.0f, 1.0f} };
+  constexpr SquareMatrix4df twice = rotation * rotation;
+  constexpr Vector4df x = twice * Vector4df{1.0f, 0.0f, 0.0f, 1.0f};
+  static_assert(twice.at(0, 0) == -1.0f && twice.at(1, 1) == -1.0f);
+  static_assert(x[0] == -1.0f && x[1] == 0.0f && x[3] == 1.0f);
+
+  SquareMatrix4df runtime = rotation;
+  EXPECT_EQ(twice.at(0, 0), (runtime * runtime).at(0, 0));
+}
+
+SquareMatrix4df trs_matrix(float x, float y, float angle, float scale) {
+  SquareMatrix4df translation = { {1.0f, 0.0f, 0.0f, 0.0f},
+                                  {0.0f, 1.0f, 0.0f, 0.0f},
+                                  {0.0f, 0.0f, 1.0f, 0.0f},
+                                  {x,    y,    0.0f, 1.0f} };
+  SquareMatrix4df rotation = { { std::cos(angle), std::sin(angle), 0.0f, 0.0f},
+                               {-std::sin(angle), std::cos(angle), 0.0f, 0.0f},
+                               { 0.0f,            0.0f,            1.0f, 0.0f},
+                               { 0.0f,            0.0f,            0.0f, 1.0f} };
+  SquareMatrix4df scaling = { {scale, 0.0f,  0.0f,  0.0f},
+                              {0.0f,  scale, 0.0f,  0.0f},
+                              {0.0f,  0.0f,  scale, 0.0f},
+                              {0.0f,  0.0f,  0.0f,  1.0f} };
+  return translation * rotation * scaling;
+}
+
+TEST(AFFINE, IdentityAndFromMatrix) {
+  Affine3df identity;
+  SquareMatrix4df matrix = trs_matrix(3.0f, -2.0f, 0.5f, 2.0f);
+  SquareMatrix4df result = Affine3df(matrix).to_matrix();
+  SquareMatrix4df unchanged = identity.to_matrix();
+
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_EQ(matrix.at(row, column), result.at(row, column));
+      EXPECT_EQ(row == column ? 1.0f : 0.0f, unchanged.at(row, column));
+    }
+  }
+}
+
+TEST(AFFINE, FromTrsEqualsMatrixProduct) {
+  for (float angle : {0.0f, 0.3f, 1.5707964f, -2.0f, 3.1f}) {
+    SquareMatrix4df expected = trs_matrix(100.0f, -37.5f, angle, 16.0f);
+    SquareMatrix4df result = Affine3df::from_trs({100.0f, -37.5f, 0.0f}, angle, 16.0f).to_matrix();
+    for (size_t row = 0; row < 4; row++) {
+      for (size_t column = 0; column < 4; column++) {
+        EXPECT_NEAR(expected.at(row, column), result.at(row, column), 0.00001);
+      }
+    }
+  }
+}
+
+TEST(AFFINE, ProductEqualsMatrixProduct) {
+  SquareMatrix4df korrektur = { {1.0f, 0.0f,  0.0f, 0.0f},
+                                {0.0f, 0.0f, -1.0f, 0.0f},
+                                {0.0f, 1.0f,  0.0f, 0.0f},
+                                {0.0f, 0.0f,  0.0f, 1.0f} };
+  Affine3df trs = Affine3df::from_trs({5.0f, 6.0f, 0.0f}, 0.7f, 3.0f);
+  SquareMatrix4df expected = trs.to_matrix() * trs_matrix(-1.0f, 2.0f, 0.2f, 0.5f) * korrektur;
+  SquareMatrix4df result = (trs * Affine3df(trs_matrix(-1.0f, 2.0f, 0.2f, 0.5f)) * Affine3df(korrektur)).to_matrix();
+
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_NEAR(expected.at(row, column), result.at(row, column), 0.00001);
+    }
+  }
+}
+
+TEST(AFFINE, TransformPoint) {
+  constexpr Affine3df trs = Affine3df::from_trs({1.0f, 2.0f, 3.0f}, 0.0f, 1.0f, 2.0f);
+  constexpr Vector3df point = trs * Vector3df{1.0f, 0.0f, 0.0f};
+  static_assert(point[0] == 1.0f && point[1] == 4.0f && point[2] == 3.0f);
+
+  Vector4df expected = trs.to_matrix() * Vector4df{1.0f, 0.0f, 0.0f, 1.0f};
+  EXPECT_EQ(expected[0], point[0]);
+  EXPECT_EQ(expected[1], point[1]);
+  EXPECT_EQ(expected[2], point[2]);
+}
+
+// die SIMD-Spezialisierungen (matrix_simd.h) muessen bitgenau mit der skalaren Linearkombination uebereinstimmen
+SquareMatrix4df simd_matrix() {
+  return { {0.1f, -2.7f, 3.3f, 1e-3f},
+           {1e7f, 3.1f, -1e-7f, 0.5f},
+           {-0.3f, 0.7f, 0.9f, -4.2f},
+           {123.456f, -0.001f, 7.0f, 1.0f} };
+}
+
+TEST(MATRIX, SimdProductWithVector4dfBitExact) {
+  SquareMatrix4df matrix = simd_matrix();
+  Vector4df vector = {0.3f, -1.7f, 2e5f, 1.0f};
+  Vector4df product = matrix * vector;
+
+  for (size_t row = 0; row < 4; row++) {
+    float sum = 0;
+    for (size_t column = 0; column < 4; column++) {
+      sum += vector[column] * matrix.at(row, column);
+    }
+    EXPECT_EQ(sum, product[row]);
+  }
+}
+
+TEST(AFFINE, SimdProductBitExact) {
+  Affine3df factor1 = Affine3df::from_trs({1e3f, -0.25f, 7.0f}, 0.3f, 2.7f);
+  Affine3df factor2 = Affine3df(SquareMatrix4df{ {0.1f, -2.7f, 3.3f, 0.0f},
+                                                 {1e7f, 3.1f, -1e-7f, 0.0f},
+                                                 {-0.3f, 0.7f, 0.9f, 0.0f},
+                                                 {123.456f, -0.001f, 7.0f, 1.0f} });
+  SquareMatrix4df matrix1 = factor1.to_matrix();
+  SquareMatrix4df matrix2 = factor2.to_matrix();
+  SquareMatrix4df product = (factor1 * factor2).to_matrix();
+
+  for (size_t column = 0; column < 4; column++) {
+    for (size_t row = 0; row < 3; row++) {
+      float sum = 0;
+      for (size_t k = 0; k < 3; k++) {
+        sum += matrix2.at(k, column) * matrix1.at(row, k);
+      }
+      if (column == 3) {
+        sum = matrix1.at(row, 3) + sum;
+      }
+      EXPECT_EQ(sum, product.at(row, column));
+    }
+  }
+}
+
+TEST(MATRIX, SimdProductWithMatrix4dfBitExact) {
+  SquareMatrix4df matrix1 = simd_matrix();
+  SquareMatrix4df matrix2 = { {1.0f, 0.5f, -0.25f, 0.0f},
+                              {3.7f, 1.0f, 11.0f, -2.0f},
+                              {0.0f, 1e-3f, 1.0f, 0.0f},
+                              {-5.0f, 2.0f, 9.0f, 1.0f} };
+  SquareMatrix4df product = matrix1 * matrix2;
+
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      float sum = 0;
+      for (size_t k = 0; k < 4; k++) {
+        sum += matrix2.at(k, column) * matrix1.at(row, k);
+      }
+      EXPECT_EQ(sum, product.at(row, column));
+    }
+  }
+}
+
+
+TEST(MATRIX, Transpose) {
+  SquareMatrix3df matrix = { {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f} };
+  SquareMatrix3df transposed = matrix.transpose();
+  SquareMatrix4df simd = simd_matrix();
+  SquareMatrix4df simd_transposed = simd.transpose();
+
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t column = 0; column < 3; column++) {
+      EXPECT_EQ(matrix.at(row, column), transposed.at(column, row));
+    }
+  }
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_EQ(simd.at(row, column), simd_transposed.at(column, row));
+    }
+  }
+}
+
+TEST(MATRIX, Determinant) {
+  SquareMatrix3df matrix = { {2.0f, 0.0f, 1.0f}, {1.0f, 3.0f, 0.0f}, {0.0f, 1.0f, 4.0f} };
+  EXPECT_NEAR(25.0f, matrix.determinant(), 1e-5f);
+  EXPECT_NEAR(8.0f, trs_matrix(3.0f, -2.0f, 0.5f, 2.0f).determinant(), 1e-5f);
+  EXPECT_EQ(0.0f, SquareMatrix3df().determinant());
+}
+
+// M * M^-1 muss die Einheitsmatrix ergeben; die 4x4-Inverse wird mit einer Rechnung in double verglichen
+TEST(MATRIX, Inverse) {
+  SquareMatrix3df matrix3 = { {2.0f, 0.0f, 1.0f}, {1.0f, 3.0f, 0.0f}, {0.0f, 1.0f, 4.0f} };
+  SquareMatrix3df identity3 = matrix3 * matrix3.inverse();
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t column = 0; column < 3; column++) {
+      EXPECT_NEAR(row == column ? 1.0f : 0.0f, identity3.at(row, column), 1e-6f);
+    }
+  }
+
+  SquareMatrix4df matrix4 = { {0.0f, 2.0f, -1.0f, 0.5f},
+                              {3.0f, 0.25f, 0.0f, 1.0f},
+                              {1.0f, -1.0f, 4.0f, 0.0f},
+                              {-2.0f, 0.0f, 1.0f, 3.0f} };
+  SquareMatrix<double, 4> matrix4d;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      matrix4d.at(row, column) = matrix4.at(row, column);
+    }
+  }
+  SquareMatrix4df inverse4 = matrix4.inverse();
+  SquareMatrix<double, 4> inverse4d = matrix4d.inverse();
+  SquareMatrix4df identity4 = matrix4 * inverse4;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_NEAR(inverse4d.at(row, column), inverse4.at(row, column), 1e-6);
+      EXPECT_NEAR(row == column ? 1.0f : 0.0f, identity4.at(row, column), 1e-6f);
+    }
+  }
+}
+
+TEST(MATRIX, InverseOfSingularMatrixThrows) {
+  SquareMatrix3df singular3 = { {1.0f, 2.0f, 3.0f}, {2.0f, 4.0f, 6.0f}, {0.0f, 1.0f, 1.0f} };
+  SquareMatrix4df singular4 = trs_matrix(1.0f, 2.0f, 0.3f, 0.0f);
+  EXPECT_THROW(singular3.inverse(), std::domain_error);
+  EXPECT_THROW(singular4.inverse(), std::domain_error);
+  EXPECT_THROW(singular4.affine_inverse(), std::domain_error);
+  EXPECT_THROW(singular4.normal_matrix(), std::domain_error);
+}
+
+// try_normal_matrix() wirft nicht, sondern liefert std::nullopt, auch fuer fast singulaere Matrizen
+TEST(MATRIX, TryNormalMatrix) {
+  SquareMatrix4df singular = trs_matrix(1.0f, 2.0f, 0.3f, 0.0f);
+  EXPECT_FALSE(singular.try_normal_matrix());
+  SquareMatrix4df flat = trs_matrix(1.0f, 2.0f, 0.3f, 1.0f) * SquareMatrix4df{ {1.0f, 0.0f, 0.0f, 0.0f},
+                                                                              {0.0f, 1e-8f, 0.0f, 0.0f},
+                                                                              {0.0f, 0.0f, 1.0f, 0.0f},
+                                                                              {0.0f, 0.0f, 0.0f, 1.0f} };
+  EXPECT_NO_THROW(flat.normal_matrix());
+  EXPECT_FALSE(flat.try_normal_matrix());
+
+  // eine gleichmaessig kleine Skalierung ist nicht singulaer
+  SquareMatrix4df tiny = trs_matrix(1.0f, 2.0f, 0.3f, 1e-4f);
+  SquareMatrix4df matrix = trs_matrix(2.0f, 3.0f, 0.7f, 1.0f) * SquareMatrix4df{ {4.0f, 0.0f, 0.0f, 0.0f},
+                                                                                {0.0f, 1.0f, 0.0f, 0.0f},
+                                                                                {0.0f, 0.0f, 0.5f, 0.0f},
+                                                                                {7.0f, 8.0f, 9.0f, 1.0f} };
+  for (const SquareMatrix4df & regular : {tiny, matrix}) {
+    const std::optional<SquareMatrix3df> normal_matrix = regular.try_normal_matrix();
+    ASSERT_TRUE(normal_matrix);
+    const SquareMatrix3df expected = regular.normal_matrix();
+    for (size_t row = 0; row < 3; row++) {
+      for (size_t column = 0; column < 3; column++) {
+        EXPECT_NEAR(expected.at(row, column), normal_matrix->at(row, column), 1e-6f * (1.0f + std::abs(expected.at(row, column))));
+      }
+    }
+  }
+  static_assert(!SquareMatrix3dd{ {1.0, 0.0, 0.0}, {0.0, 1e-12, 0.0}, {0.0, 0.0, 1.0} }.try_normal_matrix());
+  static_assert(SquareMatrix4df::identity().try_normal_matrix()->at(1, 1) == 1.0f);
+}
+
+TEST(MATRIX, AffineInverse) {
+  SquareMatrix4df matrix = trs_matrix(100.0f, -37.5f, 1.2f, 16.0f);
+  SquareMatrix4df inverse = matrix.affine_inverse();
+  SquareMatrix4df general = matrix.inverse();
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_NEAR(general.at(row, column), inverse.at(row, column), 1e-5f);
+    }
+  }
+  Vector4df point = inverse * (matrix * Vector4df{3.0f, -4.0f, 5.0f, 1.0f});
+  EXPECT_NEAR(3.0f, point[0], 1e-4f);
+  EXPECT_NEAR(-4.0f, point[1], 1e-4f);
+  EXPECT_NEAR(5.0f, point[2], 1e-4f);
+  EXPECT_EQ(1.0f, point[3]);
+}
+
+// bei ungleichmaessiger Skalierung muss die transformierte Normale senkrecht auf der transformierten Flaeche bleiben
+TEST(MATRIX, NormalMatrix) {
+  SquareMatrix4df scaling = { {4.0f, 0.0f, 0.0f, 0.0f},
+                              {0.0f, 1.0f, 0.0f, 0.0f},
+                              {0.0f, 0.0f, 0.5f, 0.0f},
+                              {7.0f, 8.0f, 9.0f, 1.0f} };
+  SquareMatrix4df matrix = trs_matrix(2.0f, 3.0f, 0.7f, 1.0f) * scaling;
+  SquareMatrix3df normal_matrix = matrix.normal_matrix();
+
+  Vector3df tangent = {1.0f, -1.0f, 0.0f};
+  Vector3df normal = {1.0f, 1.0f, 0.0f};
+  Vector4df transformed_tangent = matrix * Vector4df{tangent[0], tangent[1], tangent[2], 0.0f};
+  Vector3df transformed_normal = normal_matrix * normal;
+  EXPECT_NEAR(0.0f, transformed_tangent[0] * transformed_normal[0] + transformed_tangent[1] * transformed_normal[1]
+                      + transformed_tangent[2] * transformed_normal[2], 1e-5f);
+
+  SquareMatrix3df linear;
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t column = 0; column < 3; column++) {
+      linear.at(row, column) = matrix.at(row, column);
+    }
+  }
+  SquareMatrix3df expected = linear.inverse().transpose();
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t column = 0; column < 3; column++) {
+      EXPECT_NEAR(expected.at(row, column), normal_matrix.at(row, column), 1e-6f);
+    }
+  }
+}
+
+TEST(MATRIX, ConstexprInverse) {
+  constexpr SquareMatrix4df matrix = { {2.0f, 0.0f, 0.0f, 0.0f},
+                                       {0.0f, 4.0f, 0.0f, 0.0f},
+                                       {0.0f, 0.0f, 0.5f, 0.0f},
+                                       {1.0f, 2.0f, 3.0f, 1.0f} };
+  constexpr SquareMatrix4df inverse = matrix.inverse();
+  constexpr SquareMatrix3df normal_matrix = matrix.normal_matrix();
+  static_assert(inverse.at(0, 0) == 0.5f && inverse.at(1, 3) == -0.5f && inverse.at(2, 3) == -6.0f);
+  static_assert(normal_matrix.at(2, 2) == 2.0f);
+  EXPECT_EQ(matrix.transpose().at(3, 0), 1.0f);
+}
+
+}
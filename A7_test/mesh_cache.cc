@@ -0,0 +1,724 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+const char MAGIC[8] = "A7MESH";
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const size_t SECTION_ALIGNMENT = 64;
+const uint32_t MAX_LEAF_TRIANGLES = 4;
+const size_t MAX_LODS = 3;             // simplified versions besides the mesh itself
+const size_t MIN_LOD_TRIANGLES = 8;
+const double BORDER_WEIGHT = 10.0;     // of the planes along open borders, relative to the faces
+
+// size and modification time of the file at path, MeshCacheSource::ABSENT_SIZE and ABSENT_MODIFIED
+//   if it does not exist
+MeshCacheSource read_source(const std::string & path) {
+  MeshCacheSource source = {MeshCacheSource::ABSENT_SIZE, MeshCacheSource::ABSENT_MODIFIED,
+                            static_cast<uint32_t>(path.size()), 0u};
+  std::error_code error;
+  const uintmax_t size = std::filesystem::file_size(path, error);
+  if (error) {
+    return source;
+  }
+  const auto modified = std::filesystem::last_write_time(path, error);
+  if (error) {
+    return source;
+  }
+  source.size = static_cast<uint64_t>(size);
+  source.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+  return source;
+}
+
+// the elements of a section that is inside data
+template <class ELEMENT>
+std::span<const ELEMENT> elements(std::string_view data, const MeshCacheSection & section) {
+  return {reinterpret_cast<const ELEMENT *>(data.data() + section.offset), static_cast<size_t>(section.count)};
+}
+
+// true if all values are less than end
+bool all_below(std::span<const uint32_t> values, uint64_t end) {
+  return std::ranges::all_of(values, [end](uint32_t value) { return value < end; });
+}
+
+// true if [first, first + count) is inside a section with size elements
+bool fits(uint32_t first, uint32_t count, uint64_t size) {
+  return static_cast<uint64_t>(first) + count <= size;
+}
+
+size_t aligned(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// appends count elements at a new section of out
+template <class ELEMENT>
+void append_section(std::string & out, MeshCacheSection & section, const ELEMENT * elements, size_t count) {
+  out.resize(aligned(out.size(), SECTION_ALIGNMENT), '\0');
+  section = {out.size(), count};
+  out.append(reinterpret_cast<const char *>(elements), count * sizeof(ELEMENT));
+}
+
+// a bounding volume hierarchy with a median split along the longest axis of the centroids
+class BvhBuilder {
+  const std::vector<float> & vertices;
+  const std::vector<uint32_t> & indices;
+  std::vector<Vertice> centroids;
+public:
+  std::vector<MeshCacheNode> nodes;
+  std::vector<uint32_t> triangles;
+
+  BvhBuilder(const std::vector<float> & vertices, const std::vector<uint32_t> & indices)
+    : vertices(vertices), indices(indices) {
+    const size_t count = indices.size() / 3;
+    triangles.resize(count);
+    centroids.resize(count);
+    for (uint32_t t = 0; t < count; t++) {
+      triangles[t] = t;
+      for (size_t axis = 0; axis < 3; axis++) {
+        float sum = 0.0f;
+        for (size_t corner = 0; corner < 3; corner++) {
+          sum += vertices[indices[3 * t + corner] * MESH_CACHE_FLOATS_PER_VERTEX + axis];
+        }
+        centroids[t][axis] = sum / 3.0f;
+      }
+    }
+    if (count > 0) {
+      nodes.push_back(create_node(0, static_cast<uint32_t>(count)));
+      split(0);
+    }
+  }
+
+  // a leaf with the bounding box of triangles[first, first + count)
+  MeshCacheNode create_node(uint32_t first, uint32_t count) const {
+    MeshCacheNode node = {{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
+                          {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
+                          first, count};
+    for (uint32_t i = first; i < first + count; i++) {
+      for (size_t corner = 0; corner < 3; corner++) {
+        const float * position = &vertices[indices[3 * triangles[i] + corner] * MESH_CACHE_FLOATS_PER_VERTEX];
+        for (size_t axis = 0; axis < 3; axis++) {
+          node.min[axis] = std::min(node.min[axis], position[axis]);
+          node.max[axis] = std::max(node.max[axis], position[axis]);
+        }
+      }
+    }
+    return node;
+  }
+
+  void split(size_t node_index) {
+    const uint32_t first = nodes[node_index].first;
+    const uint32_t count = nodes[node_index].count;
+    if (count <= MAX_LEAF_TRIANGLES) {
+      return;
+    }
+    size_t axis = 0;
+    for (size_t a = 1; a < 3; a++) {
+      if (nodes[node_index].max[a] - nodes[node_index].min[a] > nodes[node_index].max[axis] - nodes[node_index].min[axis]) {
+        axis = a;
+      }
+    }
+    const uint32_t middle = first + count / 2;
+    std::nth_element(triangles.begin() + first, triangles.begin() + middle, triangles.begin() + first + count,
+                     [this, axis](uint32_t t1, uint32_t t2) { return centroids[t1][axis] < centroids[t2][axis]; });
+
+    const size_t left = nodes.size();
+    nodes.push_back(create_node(first, middle - first));
+    nodes.push_back(create_node(middle, first + count - middle));
+    nodes[node_index].first = static_cast<uint32_t>(left);
+    nodes[node_index].count = 0;
+    split(left);
+    split(left + 1);
+  }
+};
+
+// a quadric error metric: the sum of the squared distances of a point to a set of planes
+// the symmetric 4x4 matrix is stored as its upper triangle
+struct Quadric {
+  double a[10] = {};
+
+  // the plane normal * x + d = 0, |normal| = 1
+  void add_plane(const Vertice & normal, double d, double weight) {
+    const double plane[4] = {normal[0], normal[1], normal[2], d};
+    size_t k = 0;
+    for (size_t i = 0; i < 4; i++) {
+      for (size_t j = i; j < 4; j++) {
+        a[k++] += weight * plane[i] * plane[j];
+      }
+    }
+  }
+
+  void add(const Quadric & other) {
+    for (size_t k = 0; k < 10; k++) {
+      a[k] += other.a[k];
+    }
+  }
+
+  double cost(const Vertice & p) const {
+    const double x = p[0], y = p[1], z = p[2];
+    return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+         + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+         + a[7] * z * z + 2 * a[8] * z
+         + a[9];
+  }
+};
+
+Vertice subtract(const Vertice & a, const Vertice & b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+Vertice cross(const Vertice & a, const Vertice & b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+float dot(const Vertice & a, const Vertice & b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// simplifies a mesh by edge collapses with the smallest quadric error (Garland and Heckbert),
+//   a position is always moved onto one of its neighbours, so the simplified triangles use the
+//   vertices of the original mesh and only need other indices
+// the connectivity is that of the positions, vertices with the same position (other normals or
+//   colors) move together; positions with more than one color (material borders) are not moved
+//   and open borders keep their shape by additional planes perpendicular to them
+class Simplifier {
+  // a collapse of from onto to, outdated if one of the positions has changed since
+  struct Collapse {
+    double cost;
+    uint32_t from, to;
+    uint32_t from_version, to_version;
+
+    bool operator>(const Collapse & other) const {
+      return cost > other.cost;
+    }
+  };
+
+  const std::vector<float> & vertices;
+  std::vector<Vertice> positions;
+  std::vector<uint32_t> position_of;  // for each vertex
+  std::vector<uint32_t> first_vertex; // the vertices at position p are at_position[first_vertex[p], first_vertex[p + 1])
+  std::vector<uint32_t> at_position;
+  std::vector<bool> locked;
+  std::vector<bool> removed;          // for each position
+  std::vector<uint32_t> versions;
+  std::vector<Quadric> quadrics;
+  std::vector<std::vector<uint32_t>> around; // the triangles at each position
+  std::vector<std::array<uint32_t, 3>> corners;   // the vertex of each corner in the original mesh
+  std::vector<std::array<uint32_t, 3>> triangles; // the current position of each corner
+  std::vector<bool> deleted;                       // for each triangle
+  size_t triangle_count = 0;
+  double max_cost = 0.0;
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+  std::vector<uint32_t> from_neighbours, to_neighbours; // set by is_allowed()
+
+  const float * vertex(uint32_t v) const {
+    return &vertices[v * MESH_CACHE_FLOATS_PER_VERTEX];
+  }
+
+  static bool contains(const std::array<uint32_t, 3> & triangle, uint32_t p) {
+    return triangle[0] == p || triangle[1] == p || triangle[2] == p;
+  }
+
+  void push(uint32_t from, uint32_t to) {
+    if (locked[from]) {
+      return;
+    }
+    Quadric quadric = quadrics[from];
+    quadric.add(quadrics[to]);
+    queue.push({std::max(0.0, quadric.cost(positions[to])), from, to, versions[from], versions[to]});
+  }
+
+  void push_edges(uint32_t p) {
+    for (uint32_t t : around[p]) {
+      for (uint32_t q : triangles[t]) {
+        if (q != p) {
+          push(p, q);
+          push(q, p);
+        }
+      }
+    }
+  }
+
+  // the neighbours of p
+  void neighbours(uint32_t p, std::vector<uint32_t> & result) const {
+    result.clear();
+    for (uint32_t t : around[p]) {
+      for (uint32_t q : triangles[t]) {
+        if (q != p && std::find(result.begin(), result.end(), q) == result.end()) {
+          result.push_back(q);
+        }
+      }
+    }
+  }
+
+  // false if from and to are no longer connected, the collapse would make the mesh non-manifold
+  //   (the neighbours they share must be those of the triangles at the edge) or turn a triangle over
+  bool is_allowed(uint32_t from, uint32_t to) {
+    size_t edge_triangles = 0;
+    for (uint32_t t : around[from]) {
+      if (contains(triangles[t], to)) {
+        edge_triangles++;
+      }
+    }
+    if (edge_triangles == 0) {
+      return false;
+    }
+    neighbours(from, from_neighbours);
+    neighbours(to, to_neighbours);
+    size_t shared = 0;
+    for (uint32_t q : from_neighbours) {
+      shared += std::count(to_neighbours.begin(), to_neighbours.end(), q);
+    }
+    if (shared != edge_triangles) {
+      return false;
+    }
+    for (uint32_t t : around[from]) {
+      const std::array<uint32_t, 3> & triangle = triangles[t];
+      if (contains(triangle, to)) {
+        continue;
+      }
+      std::array<Vertice, 3> corner;
+      for (size_t i = 0; i < 3; i++) {
+        corner[i] = positions[triangle[i]];
+      }
+      const Vertice before = cross(subtract(corner[1], corner[0]), subtract(corner[2], corner[0]));
+      for (size_t i = 0; i < 3; i++) {
+        if (triangle[i] == from) {
+          corner[i] = positions[to];
+        }
+      }
+      const Vertice after = cross(subtract(corner[1], corner[0]), subtract(corner[2], corner[0]));
+      if (dot(before, before) > 0.0f && dot(before, after) <= 0.0f) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // after is_allowed(from, to)
+  void collapse(uint32_t from, uint32_t to) {
+    for (uint32_t t : around[from]) {
+      std::array<uint32_t, 3> & triangle = triangles[t];
+      if (contains(triangle, to)) {
+        deleted[t] = true;
+        triangle_count--;
+        continue;
+      }
+      for (uint32_t & p : triangle) {
+        if (p == from) {
+          p = to;
+        }
+      }
+      around[to].push_back(t);
+    }
+    around[from].clear();
+    removed[from] = true;
+    for (uint32_t p : from_neighbours) {
+      std::erase_if(around[p], [this](uint32_t t) { return deleted[t]; });
+    }
+    quadrics[to].add(quadrics[from]);
+    versions[to]++;
+    push_edges(to);
+  }
+public:
+  // vertices with MESH_CACHE_FLOATS_PER_VERTEX floats, three indices per triangle
+  Simplifier(const std::vector<float> & vertices, const std::vector<uint32_t> & indices) : vertices(vertices) {
+    // vertices with the same position, sorted by position
+    const size_t vertex_count = vertices.size() / MESH_CACHE_FLOATS_PER_VERTEX;
+    std::vector<uint32_t> order(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; v++) {
+      order[v] = v;
+    }
+    const auto position = [this](uint32_t v) { return Vertice{vertex(v)[0], vertex(v)[1], vertex(v)[2]}; };
+    std::sort(order.begin(), order.end(), [&position](uint32_t v1, uint32_t v2) { return position(v1) < position(v2); });
+    position_of.resize(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++) {
+      if (i == 0 || position(order[i]) != positions.back()) {
+        positions.push_back(position(order[i]));
+        first_vertex.push_back(static_cast<uint32_t>(i));
+        locked.push_back(false);
+      } else if (!std::equal(vertex(order[i]) + 6, vertex(order[i]) + 9, vertex(at_position[first_vertex.back()]) + 6)) {
+        locked.back() = true;
+      }
+      position_of[order[i]] = static_cast<uint32_t>(positions.size() - 1);
+      at_position.push_back(order[i]);
+    }
+    first_vertex.push_back(static_cast<uint32_t>(vertex_count));
+    removed.resize(positions.size(), false);
+    versions.resize(positions.size(), 0u);
+    quadrics.resize(positions.size());
+    around.resize(positions.size());
+
+    // triangles with three different positions and the planes of their faces
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+      const std::array<uint32_t, 3> corner = {indices[i], indices[i + 1], indices[i + 2]};
+      const std::array<uint32_t, 3> triangle = {position_of[corner[0]], position_of[corner[1]], position_of[corner[2]]};
+      if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+        continue;
+      }
+      const uint32_t t = static_cast<uint32_t>(triangles.size());
+      corners.push_back(corner);
+      triangles.push_back(triangle);
+      Vertice normal = cross(subtract(positions[triangle[1]], positions[triangle[0]]),
+                             subtract(positions[triangle[2]], positions[triangle[0]]));
+      const float length = std::sqrt(dot(normal, normal));
+      for (uint32_t p : triangle) {
+        around[p].push_back(t);
+      }
+      if (length == 0.0f) {
+        continue;
+      }
+      for (float & component : normal) {
+        component /= length;
+      }
+      for (uint32_t p : triangle) {
+        quadrics[p].add_plane(normal, -dot(normal, positions[triangle[0]]), 1.0);
+      }
+    }
+    deleted.resize(triangles.size(), false);
+    triangle_count = triangles.size();
+
+    // an edge of only one triangle is on an open border
+    for (uint32_t t = 0; t < triangles.size(); t++) {
+      const std::array<uint32_t, 3> & triangle = triangles[t];
+      const Vertice normal = cross(subtract(positions[triangle[1]], positions[triangle[0]]),
+                                   subtract(positions[triangle[2]], positions[triangle[0]]));
+      for (size_t i = 0; i < 3; i++) {
+        const uint32_t p = triangle[i], q = triangle[(i + 1) % 3];
+        const size_t count = std::count_if(around[p].begin(), around[p].end(),
+                                           [this, q](uint32_t other) { return contains(triangles[other], q); });
+        Vertice border = cross(subtract(positions[q], positions[p]), normal);
+        const float length = std::sqrt(dot(border, border));
+        if (count != 1 || length == 0.0f) {
+          continue;
+        }
+        for (float & component : border) {
+          component /= length;
+        }
+        for (uint32_t r : {p, q}) {
+          quadrics[r].add_plane(border, -dot(border, positions[p]), BORDER_WEIGHT);
+        }
+      }
+    }
+
+    for (uint32_t p = 0; p < positions.size(); p++) {
+      push_edges(p);
+    }
+  }
+
+  // collapses edges until there are at most target triangles or no collapse is possible
+  void simplify(size_t target) {
+    while (triangle_count > target && !queue.empty()) {
+      const Collapse next = queue.top();
+      queue.pop();
+      if (removed[next.from] || removed[next.to] || versions[next.from] != next.from_version
+          || versions[next.to] != next.to_version || !is_allowed(next.from, next.to)) {
+        continue;
+      }
+      collapse(next.from, next.to);
+      max_cost = std::max(max_cost, next.cost);
+    }
+  }
+
+  size_t get_triangle_count() const {
+    return triangle_count;
+  }
+
+  // about the largest distance of the simplified surface to the original one
+  float get_error() const {
+    return static_cast<float>(std::sqrt(max_cost));
+  }
+
+  // appends the indices of the remaining triangles; for a corner that has been moved, the vertex at
+  //   its new position with the same color and the most similar normal is used
+  void append_indices(std::vector<uint32_t> & indices) const {
+    for (uint32_t t = 0; t < triangles.size(); t++) {
+      if (deleted[t]) {
+        continue;
+      }
+      for (size_t i = 0; i < 3; i++) {
+        const uint32_t original = corners[t][i];
+        const uint32_t p = triangles[t][i];
+        if (position_of[original] == p) {
+          indices.push_back(original);
+          continue;
+        }
+        const float * wanted = vertex(original);
+        uint32_t best = at_position[first_vertex[p]];
+        float best_similarity = std::numeric_limits<float>::lowest();
+        for (uint32_t k = first_vertex[p]; k < first_vertex[p + 1]; k++) {
+          const float * candidate = vertex(at_position[k]);
+          float similarity = candidate[3] * wanted[3] + candidate[4] * wanted[4] + candidate[5] * wanted[5];
+          if (!std::equal(candidate + 6, candidate + 9, wanted + 6)) {
+            similarity -= 4.0f; // another color only if there is no vertex with the same one
+          }
+          if (similarity > best_similarity) {
+            best = at_position[k];
+            best_similarity = similarity;
+          }
+        }
+        indices.push_back(best);
+      }
+    }
+  }
+};
+
+}
+
+CachedMesh::CachedMesh(const std::string & obj_path) {
+  const std::string path = cache_path(obj_path);
+  file.emplace(path);
+  if (is_valid(file->view())) {
+    data = file->view();
+    return;
+  }
+  file.reset();
+  was_created = true;
+
+  WavefrontImporter importer;
+  std::vector<std::string> sources;
+  if (std::filesystem::exists(obj_path)) {
+    importer.parse_file_indexed(obj_path, 0);
+    sources.push_back(obj_path);
+    sources.insert(sources.end(), importer.get_material_libraries().begin(), importer.get_material_libraries().end());
+  }
+  created = create(importer, sources);
+  data = created;
+  if (sources.empty()) {
+    return;
+  }
+
+  // written under another name first, a concurrently started program never maps a partial cache
+  const std::string temporary_path = path + ".tmp";
+  {
+    std::ofstream out(temporary_path, std::ios::binary | std::ios::trunc);
+    out.write(created.data(), static_cast<std::streamsize>(created.size()));
+    if (!out) {
+      warning("could not write mesh cache " + path);
+      return;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary_path, path, error);
+  if (error) {
+    warning("could not write mesh cache " + path);
+  }
+}
+
+std::string CachedMesh::cache_path(const std::string & obj_path) {
+  return std::filesystem::path(obj_path).replace_extension(".mesh").string();
+}
+
+std::string CachedMesh::create(WavefrontImporter & importer, const std::vector<std::string> & sources) {
+  const IndexedMesh & mesh = importer.get_mesh();
+  MeshCacheHeader header = {};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = MESH_CACHE_VERSION;
+  header.byte_order = BYTE_ORDER_MARK;
+
+  // a missing material file is recorded as absent, the cache is rebuilt when it appears
+  std::string source_table;
+  for (const std::string & path : sources) {
+    const MeshCacheSource source = read_source(path);
+    source_table.append(reinterpret_cast<const char *>(&source), sizeof(source));
+    source_table.append(path);
+    source_table.resize(aligned(source_table.size(), 8), '\0');
+  }
+
+  // the materials in the order of their handles, so a handle is the index in the table
+  std::vector<MeshCacheMaterial> materials;
+  const Registry<Material> & registry = importer.get_materials();
+  for (uint32_t i = 0; i < registry.size(); i++) {
+    MeshCacheMaterial cached = {};
+    registry.name({i}).copy(cached.name, sizeof(cached.name) - 1);
+    cached.ambient = registry[{i}].ambient;
+    materials.push_back(cached);
+  }
+
+  // a vertex used by faces with different materials needs one copy per color
+  std::vector<MeshCacheRange> ranges;
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  indices.reserve(mesh.indices.size());
+  std::unordered_map<uint64_t, uint32_t> vertex_index;
+  for (const IndexedMesh::MaterialRange & range : mesh.material_ranges) {
+    const uint32_t material = range.material.is_valid() ? range.material.index : MeshCacheRange::NO_MATERIAL;
+    const Color color = material == MeshCacheRange::NO_MATERIAL ? Color{1.0f, 1.0f, 1.0f} : materials[material].ambient;
+    ranges.push_back({range.first, range.count, material});
+    for (uint32_t i = range.first; i < range.first + range.count; i++) {
+      const uint32_t vertex = mesh.indices[i];
+      const auto [entry, inserted] = vertex_index.try_emplace((static_cast<uint64_t>(material) << 32) | vertex,
+                                                              static_cast<uint32_t>(vertices.size() / MESH_CACHE_FLOATS_PER_VERTEX));
+      if (inserted) {
+        vertices.insert(vertices.end(), mesh.positions[vertex].begin(), mesh.positions[vertex].end());
+        vertices.insert(vertices.end(), mesh.normals[vertex].begin(), mesh.normals[vertex].end());
+        vertices.insert(vertices.end(), color.begin(), color.end());
+      }
+      indices.push_back(entry->second);
+    }
+  }
+
+  BvhBuilder bvh(vertices, indices);
+  if (!bvh.nodes.empty()) {
+    std::copy(bvh.nodes[0].min, bvh.nodes[0].min + 3, header.bounds_min);
+    std::copy(bvh.nodes[0].max, bvh.nodes[0].max + 3, header.bounds_max);
+  }
+
+  // every lod has at most half the triangles of the one before
+  std::vector<MeshCacheLod> lods;
+  std::vector<uint32_t> lod_indices;
+  Simplifier simplifier(vertices, indices);
+  size_t triangles = indices.size() / 3;
+  while (lods.size() < MAX_LODS && triangles / 2 >= MIN_LOD_TRIANGLES) {
+    simplifier.simplify(triangles / 2);
+    if (simplifier.get_triangle_count() > triangles * 3 / 4) {
+      break;
+    }
+    triangles = simplifier.get_triangle_count();
+    lods.push_back({static_cast<uint32_t>(lod_indices.size()), static_cast<uint32_t>(3 * triangles), simplifier.get_error()});
+    simplifier.append_indices(lod_indices);
+  }
+
+  std::string out(sizeof(MeshCacheHeader), '\0');
+  append_section(out, header.sources, source_table.data(), source_table.size());
+  header.sources.count = sources.size();
+  append_section(out, header.materials, materials.data(), materials.size());
+  append_section(out, header.ranges, ranges.data(), ranges.size());
+  append_section(out, header.vertices, vertices.data(), vertices.size());
+  header.vertices.count /= MESH_CACHE_FLOATS_PER_VERTEX;
+  append_section(out, header.indices, indices.data(), indices.size());
+  append_section(out, header.nodes, bvh.nodes.data(), bvh.nodes.size());
+  append_section(out, header.node_triangles, bvh.triangles.data(), bvh.triangles.size());
+  append_section(out, header.lods, lods.data(), lods.size());
+  append_section(out, header.lod_indices, lod_indices.data(), lod_indices.size());
+  std::memcpy(out.data(), &header, sizeof(header));
+  return out;
+}
+
+bool CachedMesh::is_valid(std::string_view data) {
+  MeshCacheHeader header;
+  if (data.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != MESH_CACHE_VERSION
+      || header.byte_order != BYTE_ORDER_MARK) {
+    return false;
+  }
+  const auto inside = [&data](const MeshCacheSection & section, size_t element_size) {
+    return section.offset % SECTION_ALIGNMENT == 0 && section.offset <= data.size()
+           && section.count <= (data.size() - section.offset) / element_size;
+  };
+  if (!inside(header.materials, sizeof(MeshCacheMaterial)) || !inside(header.ranges, sizeof(MeshCacheRange))
+      || !inside(header.vertices, MESH_CACHE_FLOATS_PER_VERTEX * sizeof(float))
+      || !inside(header.indices, sizeof(uint32_t)) || !inside(header.nodes, sizeof(MeshCacheNode))
+      || !inside(header.node_triangles, sizeof(uint32_t)) || !inside(header.lods, sizeof(MeshCacheLod))
+      || !inside(header.lod_indices, sizeof(uint32_t)) || header.sources.offset > data.size()) {
+    return false;
+  }
+
+  size_t position = header.sources.offset;
+  for (uint64_t i = 0; i < header.sources.count; i++) {
+    MeshCacheSource cached;
+    if (data.size() - position < sizeof(cached)) {
+      return false;
+    }
+    std::memcpy(&cached, data.data() + position, sizeof(cached));
+    position += sizeof(cached);
+    if (data.size() - position < cached.path_length) {
+      return false;
+    }
+    const MeshCacheSource current = read_source(std::string(data.substr(position, cached.path_length)));
+    if (current.size != cached.size || current.modified != cached.modified) {
+      return false;
+    }
+    position = aligned(position + cached.path_length, 8);
+  }
+
+  // a damaged cache must not make the renderer or a traversal of the nodes read outside of the sections
+  const uint64_t triangles = header.indices.count / 3;
+  if (header.indices.count % 3 != 0 || header.lod_indices.count % 3 != 0
+      || !all_below(elements<uint32_t>(data, header.indices), header.vertices.count)
+      || !all_below(elements<uint32_t>(data, header.lod_indices), header.vertices.count)
+      || !all_below(elements<uint32_t>(data, header.node_triangles), triangles)) {
+    return false;
+  }
+  for (const MeshCacheMaterial & material : elements<MeshCacheMaterial>(data, header.materials)) {
+    if (std::memchr(material.name, '\0', sizeof(material.name)) == nullptr) {
+      return false;
+    }
+  }
+  for (const MeshCacheRange & range : elements<MeshCacheRange>(data, header.ranges)) {
+    if (!fits(range.first, range.count, header.indices.count)
+        || (range.material != MeshCacheRange::NO_MATERIAL && range.material >= header.materials.count)) {
+      return false;
+    }
+  }
+  for (const MeshCacheLod & lod : elements<MeshCacheLod>(data, header.lods)) {
+    if (lod.first % 3 != 0 || lod.count % 3 != 0 || !fits(lod.first, lod.count, header.lod_indices.count)) {
+      return false;
+    }
+  }
+  // the children of a node come after it, so a traversal ends
+  const std::span<const MeshCacheNode> nodes = elements<MeshCacheNode>(data, header.nodes);
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (nodes[i].count == 0 ? nodes[i].first <= i || !fits(nodes[i].first, 2, nodes.size())
+                            : !fits(nodes[i].first, nodes[i].count, header.node_triangles.count)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CachedMesh::is_created() const {
+  return was_created;
+}
+
+template <class ELEMENT>
+std::span<const ELEMENT> CachedMesh::section(const MeshCacheSection & section) const {
+  return elements<ELEMENT>(data, section);
+}
+
+const MeshCacheHeader & CachedMesh::get_header() const {
+  return *reinterpret_cast<const MeshCacheHeader *>(data.data());
+}
+
+std::span<const float> CachedMesh::get_vertices() const {
+  const MeshCacheSection & vertices = get_header().vertices;
+  return section<float>({vertices.offset, vertices.count * MESH_CACHE_FLOATS_PER_VERTEX});
+}
+
+std::span<const uint32_t> CachedMesh::get_indices() const {
+  return section<uint32_t>(get_header().indices);
+}
+
+std::span<const MeshCacheMaterial> CachedMesh::get_materials() const {
+  return section<MeshCacheMaterial>(get_header().materials);
+}
+
+std::span<const MeshCacheRange> CachedMesh::get_ranges() const {
+  return section<MeshCacheRange>(get_header().ranges);
+}
+
+std::span<const MeshCacheNode> CachedMesh::get_nodes() const {
+  return section<MeshCacheNode>(get_header().nodes);
+}
+
+std::span<const uint32_t> CachedMesh::get_node_triangles() const {
+  return section<uint32_t>(get_header().node_triangles);
+}
+
+std::span<const MeshCacheLod> CachedMesh::get_lods() const {
+  return section<MeshCacheLod>(get_header().lods);
+}
+
+std::span<const uint32_t> CachedMesh::get_lod_indices() const {
+  return section<uint32_t>(get_header().lod_indices);
+}
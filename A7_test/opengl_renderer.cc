@@ -1,71 +1,55 @@
 #include "opengl_renderer.h"
 #include <cassert>
 #include <span>
+#include <array>
 #include <utility>
 #include <vector>
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include "mesh_cache.h"
 
 // --- Hilfsfunktionen ---
 
-// Erstellt ein VBO aus einer OBJ-Datei.
-// Gibt {VBO_ID, Vertex_Count} zurück
-std::pair<GLuint, size_t> erstelle_vbo_von_obj(const std::string& dateiname) {
-    // Versuch, lokal oder im Ordner A7_test zu öffnen
+// Sucht eine OBJ-Datei lokal oder im Ordner A7_test, leer falls sie nicht existiert
+std::string finde_obj_datei(const std::string& dateiname) {
     std::string pfad = dateiname;
-    std::ifstream eingabe_datei(pfad);
-    if (!eingabe_datei.is_open()) {
+    if (!std::filesystem::exists(pfad)) {
         pfad = "A7_test/" + dateiname;
-        eingabe_datei.open(pfad);
-        if (!eingabe_datei.is_open()) {
+        if (!std::filesystem::exists(pfad)) {
             std::cerr << "Fehler: Konnte OBJ-Datei " << dateiname << " nicht öffnen" << std::endl;
-            // Gib leer zurück, um Absturz zu vermeiden, auch wenn nichts gerendert wird
-            return {0, 0}; 
+            return {}; 
         }
     }
+    return pfad;
+}
 
-    WavefrontImporter importer(eingabe_datei);
-    importer.parse();
-    
-    std::vector<float> puffer_daten;
-    
-    // Verschränkt: Pos(3), Normal(3), Farbe(3)
-    for (const auto& face : importer.get_faces()) {
-        const auto& mat = face.material;
-        Color farbe = {1.0f, 1.0f, 1.0f}; 
-        if (mat) {
-            farbe = mat->ambient;
-        }
-
-        for (const auto& ref : face.reference_groups) {
-            // Position
-            puffer_daten.push_back(ref.vertice[0]);
-            puffer_daten.push_back(ref.vertice[1]);
-            puffer_daten.push_back(ref.vertice[2]);
-            
-            // Normale
-            puffer_daten.push_back(ref.normal[0]);
-            puffer_daten.push_back(ref.normal[1]);
-            puffer_daten.push_back(ref.normal[2]);
-
-            // Farbe
-            puffer_daten.push_back(farbe[0]);
-            puffer_daten.push_back(farbe[1]);
-            puffer_daten.push_back(farbe[2]);
-        }
+// Erstellt VBO und Indexpuffer aus dem Cache einer OBJ-Datei.
+// Die OBJ-Datei wird nur beim ersten Start geparst, danach werden die Daten direkt aus der
+// gemappten Cache-Datei hochgeladen (siehe mesh_cache.h)
+Model erstelle_vbo_von_mesh(const CachedMesh& mesh) {
+    Model model;
+    glGenBuffers(1, &model.vbo);//holl mal id
+    glBindBuffer(GL_ARRAY_BUFFER, model.vbo);//nutzen id
+    glBufferData(GL_ARRAY_BUFFER, mesh.get_vertices().size_bytes(), mesh.get_vertices().data(), GL_STATIC_DRAW);
+    // ohne gebundenes VAO als GL_ARRAY_BUFFER hochladen, als Indexpuffer wird er erst im VAO einer OpenGLView gebunden
+    // die Indizes der Detailstufen folgen im selben Puffer auf die des ganzen Modells
+    glGenBuffers(1, &model.ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, model.ebo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.get_indices().size_bytes() + mesh.get_lod_indices().size_bytes(), nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mesh.get_indices().size_bytes(), mesh.get_indices().data());
+    glBufferSubData(GL_ARRAY_BUFFER, mesh.get_indices().size_bytes(), mesh.get_lod_indices().size_bytes(), mesh.get_lod_indices().data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    model.count = mesh.get_indices().size();
+    for (const MeshCacheLod & lod : mesh.get_lods()) {
+        model.lods.push_back({model.count + lod.first, lod.count, lod.error});
     }
-    
-    GLuint vbo;
-    glGenBuffers(1, &vbo);//holl mal id
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);//nutzen id
-    glBufferData(GL_ARRAY_BUFFER, puffer_daten.size() * sizeof(float), puffer_daten.data(), GL_STATIC_DRAW);
-    //copy zur graka
-    return {vbo, puffer_daten.size() / 9}; 
+    return model;
 }
 
 // Erstellt ein VBO aus alten 2D-Vektoren (auf 3D erweitert)
-std::pair<GLuint, size_t> erstelle_vbo_von_2d(const std::vector<Vector2df>& punkte) {
+Model erstelle_vbo_von_2d(std::span<const Vector2df> punkte) {
     std::vector<float> puffer_daten;
     // Für Linien/Punkte duplizieren wir einfach die Vertices
     // Wir nehmen weiße Farbe und Z=0, Normale=(0,0,1) an
@@ -92,20 +76,49 @@ std::pair<GLuint, size_t> erstelle_vbo_von_2d(const std::vector<Vector2df>& punk
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, puffer_daten.size() * sizeof(float), puffer_daten.data(), GL_STATIC_DRAW);
     
-    return {vbo, puffer_daten.size() / 9};
+    return {vbo, 0, puffer_daten.size() / 9, {}};
 }
 
-// Legacy Digit Data for Score
-std::vector<Vector2df> digit_0 = { {0,-8}, {4,-8}, {4,0}, {0,0}, {0, -8} };
-std::vector<Vector2df> digit_1 = { {4,0}, {4,-8} };
-std::vector<Vector2df> digit_2 = { {0,-8}, {4,-8}, {4,-4}, {0,-4}, {0,0}, {4,0}  };
-std::vector<Vector2df> digit_3 = { {0,0}, {4, 0}, {4,-4}, {0,-4}, {4,-4}, {4, -8}, {0, -8}  };
-std::vector<Vector2df> digit_4 = { {4,0}, {4,-8}, {4,-4}, {0,-4}, {0,-8}  };
-std::vector<Vector2df> digit_5 = { {0,0}, {4,0}, {4,-4}, {0,-4}, {0,-8}, {4, -8}  };
-std::vector<Vector2df> digit_6 = { {0,-8}, {0,0}, {4,0}, {4,-4}, {0,-4} };
-std::vector<Vector2df> digit_7 = { {0,-8}, {4,-8}, {4,0} };
-std::vector<Vector2df> digit_8 = { {0,-8}, {4,-8}, {4,0}, {0,0}, {0,-8}, {0, -4}, {4, -4} };
-std::vector<Vector2df> digit_9 = { {4, 0}, {4,-8}, {0,-8}, {0, -4}, {4, -4} };
+// Platzhalter für Modelle, die noch geladen werden: ein Quadrat mit Diagonalen im Stil der Ziffern
+static constexpr auto platzhalter = std::to_array<Vector2df>({ {-1,-1}, {1,-1}, {1,1}, {-1,1}, {-1,-1}, {1,1}, {-1,1}, {1,-1} });
+
+// Legacy Digit Data for Score (zur Compile-Zeit erstellt)
+static constexpr auto digit_0 = std::to_array<Vector2df>({ {0,-8}, {4,-8}, {4,0}, {0,0}, {0, -8} });
+static constexpr auto digit_1 = std::to_array<Vector2df>({ {4,0}, {4,-8} });
+static constexpr auto digit_2 = std::to_array<Vector2df>({ {0,-8}, {4,-8}, {4,-4}, {0,-4}, {0,0}, {4,0}  });
+static constexpr auto digit_3 = std::to_array<Vector2df>({ {0,0}, {4, 0}, {4,-4}, {0,-4}, {4,-4}, {4, -8}, {0, -8}  });
+static constexpr auto digit_4 = std::to_array<Vector2df>({ {4,0}, {4,-8}, {4,-4}, {0,-4}, {0,-8}  });
+static constexpr auto digit_5 = std::to_array<Vector2df>({ {0,0}, {4,0}, {4,-4}, {0,-4}, {0,-8}, {4, -8}  });
+static constexpr auto digit_6 = std::to_array<Vector2df>({ {0,-8}, {0,0}, {4,0}, {4,-4}, {0,-4} });
+static constexpr auto digit_7 = std::to_array<Vector2df>({ {0,-8}, {4,-8}, {4,0} });
+static constexpr auto digit_8 = std::to_array<Vector2df>({ {0,-8}, {4,-8}, {4,0}, {0,0}, {0,-8}, {0, -4}, {4, -4} });
+static constexpr auto digit_9 = std::to_array<Vector2df>({ {4, 0}, {4,-8}, {0,-8}, {0, -4}, {4, -4} });
+
+// --- Feste Transformationen (zur Compile-Zeit berechnet) ---
+
+static constexpr SquareMatrix4df identitaet = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}};
+
+// bildet die z-Achse der OBJ-Modelle auf die y-Achse der Welt ab
+static constexpr SquareMatrix4df korrektur = {{ 1.0f, 0.0f, 0.0f, 0.0f},
+                                              { 0.0f, 0.0f,-1.0f, 0.0f},
+                                              { 0.0f, 1.0f, 0.0f, 0.0f},
+                                              { 0.0f, 0.0f, 0.0f, 1.0f} };
+
+static constexpr SquareMatrix4df rotZ_minus90 = {{  0.0f, -1.0f, 0.0f, 0.0f},
+                                                 {  1.0f,  0.0f, 0.0f, 0.0f},
+                                                 {  0.0f,  0.0f, 1.0f, 0.0f},
+                                                 {  0.0f,  0.0f, 0.0f, 1.0f} };
+
+// Achsenkorrektur fuer Raumschiff und Torpedo
+static constexpr SquareMatrix4df kombiniert = rotZ_minus90 * korrektur;
+
+// transformation to canonical view (Top-Down Ortho-ish)
+static constexpr SquareMatrix4df canonical_transform = {
+        { 2.0f / 1024.0f,           0.0f,            0.0f,  0.0f},
+        {       0.0f,     -2.0f / 768.0f,            0.0f,  0.0f},
+        {       0.0f,               0.0f,  2.0f / 1024.0f,  0.0f}, 
+        {      -1.0f,               1.0f,           0.0f,  1.0f}  
+    };
 
 /* ORIGINAL CODE:
 std::vector<Vector2df> spaceship = {
@@ -251,13 +264,23 @@ std::vector< std::vector<Vector2df> * > vertice_data = {
 
 
 
-OpenGLView::OpenGLView(GLuint vbo, unsigned int shaderProgram, size_t vertices_size, GLuint mode)
-: shaderProgram(shaderProgram), vertices_size(vertices_size), mode(mode) {
+OpenGLView::OpenGLView(const Model & model, unsigned int shaderProgram, GLuint mode)
+: shaderProgram(shaderProgram), model(&model), mode(mode) {
+    if (model.vbo != 0) {
+        create_vao();
+    }
+}
+
+void OpenGLView::create_vao() {
     glGenVertexArrays(1, &vao);
    
     glBindVertexArray(vao);
    
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
+    if (model->ebo != 0) {
+        // der Indexpuffer gehört zum Zustand des VAO
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
+    }
 
     // Stride = 9 * float (Pos3, Norm3, Col3)
     GLsizei stride = 9 * sizeof(float);
@@ -285,46 +308,71 @@ OpenGLView::OpenGLView(GLuint vbo, unsigned int shaderProgram, size_t vertices_s
 }
 
 OpenGLView::~OpenGLView() {
-    glDeleteVertexArrays(1, &vao);
+    if (vao != 0) {
+        glDeleteVertexArrays(1, &vao);
+    }
 }
 
-void OpenGLView::render( SquareMatrix<float,4> & matrice) {
+// größte Abweichung einer Detailstufe auf dem Bildschirm
+static constexpr float max_lod_fehler_pixel = 1.0f;
+
+bool OpenGLView::render( SquareMatrix<float,4> & matrice, float pixel_pro_einheit) {
+    if (vao == 0) {
+        if (model->vbo == 0) {
+            return false;
+        }
+        // das Modell wurde seit dem letzten Aufruf hochgeladen
+        create_vao();
+    }
     glBindVertexArray(vao);
     glUseProgram(shaderProgram);
     unsigned int transformLoc = glGetUniformLocation(shaderProgram, "transform");
     glUniformMatrix4fv(transformLoc, 1, GL_FALSE, &matrice[0][0] ); 
-    glDrawArrays(mode, 0, vertices_size );
+    // Normalen mit der Inversen der Transponierten transformieren, damit sie auch bei
+    // ungleichmäßiger Skalierung senkrecht auf den Flächen bleiben
+    const std::optional<SquareMatrix3df> normal_matrix = matrice.try_normal_matrix();
+    if (!normal_matrix) {
+        // auf eine Fläche oder einen Punkt (fast) zusammengedrücktes Objekt ist nicht sichtbar
+        return true;
+    }
+    unsigned int normalLoc = glGetUniformLocation(shaderProgram, "normal_matrix");
+    glUniformMatrix3fv(normalLoc, 1, GL_FALSE, &(*normal_matrix)[0][0] );
+    if (model->ebo != 0) {
+        size_t first = 0;
+        size_t count = model->count;
+        for (const Model::Lod & lod : model->lods) {
+            if (lod.error * pixel_pro_einheit > max_lod_fehler_pixel) {
+                break;
+            }
+            first = lod.first;
+            count = lod.count;
+        }
+        glDrawElements(mode, count, GL_UNSIGNED_INT, (void*)(first * sizeof(GLuint)));
+    } else {
+        glDrawArrays(mode, 0, model->count );
+    }
     debug(2, "render() exit.");
+    return true;
 }
 
 
 
 
-TypedBodyView::TypedBodyView(TypedBody * typed_body, GLuint vbo, unsigned int shaderProgram, size_t vertices_size, float scale, GLuint mode, SquareMatrix4df achsen_korrektur,
+TypedBodyView::TypedBodyView(TypedBody * typed_body, const Model & model, OpenGLView * platzhalter, unsigned int shaderProgram, float scale, GLuint mode, SquareMatrix4df achsen_korrektur,
             std::function<bool()> draw, std::function<void(TypedBodyView *)> modify)
-    : OpenGLView(vbo, shaderProgram, vertices_size, mode),  typed_body(typed_body), scale(scale), achsen_korrektur(achsen_korrektur), draw(draw), modify(modify) {
+    : OpenGLView(model, shaderProgram, mode),  typed_body(typed_body), scale(scale), achsen_korrektur(Affine3df(achsen_korrektur)), platzhalter(platzhalter), draw(draw), modify(modify) {
 }
 
-SquareMatrix4df TypedBodyView::create_object_transformation(Vector2df direction, float angle, float scale) {
-    SquareMatrix4df  translation= { {1.0f,        0.0f,          0.0f, 0.0f},
-                                    {0.0f,        1.0f,          0.0f, 0.0f},
-                                    {0.0f,        0.0f,          1.0f, 0.0f},
-                                    {direction[0], direction[1], 0.0f, 1.0f}
-                                };
-    // Drehung um Z-Achse (Lenkung)
-    SquareMatrix4df rotation = { { std::cos(angle),  std::sin(angle), 0.0f, 0.0f},
-                                {-std::sin(angle),  std::cos(angle), 0.0f, 0.0f},
-                                { 0.0f,             0.0f,            1.0f, 0.0f},
-                                { 0.0f,             0.0f,            0.0f, 1.0f}
-                            };
-    SquareMatrix4df  scaling = { { scale,    0.0f, 0.0f,   0.0f},
-                                {  0.0f,   scale, 0.0f,   0.0f},
-                                {  0.0f,    0.0f, scale,  0.0f},
-                                {  0.0f,    0.0f, 0.0f,   1.0f}
-                            };                                 
-
-    // Reihenfolge: Verschieben -> Rotieren(Z) -> Skalieren -> Achsenkorrektur(Modell-Raum)
-    return translation * rotation * scaling * achsen_korrektur;
+Affine3df TypedBodyView::create_object_transformation(Vector2df direction, float angle, Quaterniondf orientation, float scale) {
+    // Drehung um z nur neu berechnen, wenn sich der Winkel geändert hat (z.B. nicht bei Asteroiden)
+    if (angle != cached_angle) {
+        cached_angle = angle;
+        rotation_z = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, angle, FastMath{});
+    }
+    // Reihenfolge: Verschieben -> Rotieren(Z) -> Orientierung -> Skalieren, die Achsenkorrektur(Modell-Raum)
+    // folgt in render() nur für das Modell
+    // die Drehungen werden als Quaternionen verknuepft, nur das Ergebnis wird in eine Matrix umgewandelt
+    return (rotation_z * orientation).to_affine({direction[0], direction[1], 0.0f}, scale);
 }
 
 /*
@@ -349,11 +397,17 @@ SquareMatrix4df TypedBodyView::create_object_transformation(Vector2df direction,
   }
 */
 
-void TypedBodyView::render( SquareMatrix<float,4> & world) {
+void TypedBodyView::render( SquareMatrix<float,4> & world, float pixel_pro_welteinheit) {
     if ( draw() ) {
         modify(this);
-        auto transform = world * create_object_transformation(typed_body->get_position(), typed_body->get_angle(), scale);
-        OpenGLView::render(transform);
+        Affine3df bewegung = create_object_transformation(typed_body->get_position(), typed_body->get_angle(),
+                                                          typed_body->get_orientation(), scale);
+        auto transform = world * (bewegung * achsen_korrektur).to_matrix();
+        if (!OpenGLView::render(transform, scale * pixel_pro_welteinheit) && platzhalter != nullptr) {
+            // ohne Achsenkorrektur liegt der Platzhalter in der x/y Ebene
+            auto platzhalter_transform = world * bewegung.to_matrix();
+            platzhalter->render(platzhalter_transform);
+        }
     }
 }
 
@@ -368,151 +422,145 @@ void TypedBodyView::set_scale(float scale) {
 
 
 void OpenGLRenderer::createVbos() {
-    // Lade 3D Modelle
-    model_map["spaceship"] = erstelle_vbo_von_obj("space_ship.obj");
-    model_map["asteroid"] = erstelle_vbo_von_obj("asteroid.obj");
-    model_map["torpedo"] = erstelle_vbo_von_obj("torpedo.obj");
-    model_map["saucer"] = erstelle_vbo_von_obj("ufo.obj");
+    // Lade 3D Modelle in den Worker-Threads, bis zum Hochladen bleiben sie ohne VBO
+    spaceship_model = load_model("spaceship", "space_ship.obj");
+    asteroid_model = load_model("asteroid", "asteroid.obj");
+    torpedo_model = load_model("torpedo", "torpedo.obj");
+    saucer_model = load_model("saucer", "ufo.obj");
     
     // Benutze 'torpedo' oder 'asteroid' für Trümmer, falls kein spezielles Trümmer-Objekt existiert
-    model_map["debris"] = erstelle_vbo_von_obj("asteroid.obj"); // Wiederverwendung
+    debris_model = load_model("debris", "asteroid.obj"); // Wiederverwendung, die Datei wird nur einmal geladen
 
     // Lade 2D Ziffern
-    model_map["digit_0"] = erstelle_vbo_von_2d(digit_0);
-    model_map["digit_1"] = erstelle_vbo_von_2d(digit_1);
-    model_map["digit_2"] = erstelle_vbo_von_2d(digit_2);
-    model_map["digit_3"] = erstelle_vbo_von_2d(digit_3);
-    model_map["digit_4"] = erstelle_vbo_von_2d(digit_4);
-    model_map["digit_5"] = erstelle_vbo_von_2d(digit_5);
-    model_map["digit_6"] = erstelle_vbo_von_2d(digit_6);
-    model_map["digit_7"] = erstelle_vbo_von_2d(digit_7);
-    model_map["digit_8"] = erstelle_vbo_von_2d(digit_8);
-    model_map["digit_9"] = erstelle_vbo_von_2d(digit_9);
+    const std::array<std::span<const Vector2df>, 10> ziffern = { digit_0, digit_1, digit_2, digit_3, digit_4,
+                                                                 digit_5, digit_6, digit_7, digit_8, digit_9 };
+    for (size_t i = 0; i < ziffern.size(); i++) {
+        digit_models[i] = models.intern("digit_" + std::to_string(i));
+        models[digit_models[i]] = erstelle_vbo_von_2d(ziffern[i]);
+        vbo_list.push_back(models[digit_models[i]].vbo);
+    }
+    placeholder_model = models.intern("placeholder");
+    models[placeholder_model] = erstelle_vbo_von_2d(platzhalter);
+    vbo_list.push_back(models[placeholder_model].vbo);
+}
+
+// fordert die OBJ-Datei beim asset_loader an, das Modell erhält sein VBO, sobald es hochgeladen ist
+Handle<Model> OpenGLRenderer::load_model(const std::string & name, const std::string & dateiname) {
+    Handle<Model> modell = models.intern(name);
+    std::string pfad = finde_obj_datei(dateiname);
+    if (pfad.empty()) {
+        // ohne Datei bleibt der Platzhalter sichtbar
+        return modell;
+    }
+    if (!ladende_modelle.contains(pfad)) {
+        asset_loader->load(pfad);
+    }
+    ladende_modelle.emplace(pfad, modell);
+    return modell;
+}
+
+// lädt die in den Worker-Threads fertig gewordenen Modelle hoch, die Views erstellen ihr VAO beim nächsten render()
+void OpenGLRenderer::upload_loaded_models() {
+    for (LoadedMesh & geladen : asset_loader->take_loaded()) {
+        auto [anfang, ende] = ladende_modelle.equal_range(geladen.path);
+        if (geladen.mesh == nullptr) {
+            std::cerr << "Fehler: Konnte OBJ-Datei " << geladen.path << " nicht laden" << std::endl;
+        } else {
+            Model model = erstelle_vbo_von_mesh(*geladen.mesh);
+            vbo_list.push_back(model.vbo);
+            vbo_list.push_back(model.ebo);
+            for (auto it = anfang; it != ende; ++it) {
+                models[it->second] = model;
+            }
+        }
+        ladende_modelle.erase(anfang, ende);
+    }
 }
 
 void OpenGLRenderer::create(Spaceship * ship, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-    auto [vbo, count] = model_map["spaceship"];
-    
-    SquareMatrix4df korrektur =  {{ 1.0f, 0.0f, 0.0f, 0.0f},
-                                  { 0.0f, 0.0f,-1.0f, 0.0f},
-                                  { 0.0f, 1.0f, 0.0f, 0.0f},
-                                  { 0.0f, 0.0f, 0.0f, 1.0f} };
-                                  
-    SquareMatrix4df rotZ_minus90 = {{  0.0f, -1.0f, 0.0f, 0.0f},
-                                    {  1.0f,  0.0f, 0.0f, 0.0f},
-                                    {  0.0f,  0.0f, 1.0f, 0.0f},
-                                    {  0.0f,  0.0f, 0.0f, 1.0f} };
-                                    
-    SquareMatrix4df kombiniert = rotZ_minus90 * korrektur;
-
-    views.push_back(std::make_unique<TypedBodyView>(ship, vbo, shaderProgram, count, 16.0f, GL_TRIANGLES, kombiniert,
+    const Model & model = models[spaceship_model];
+
+    views.push_back(std::make_unique<TypedBodyView>(ship, model, placeholder_view.get(), shaderProgram, 16.0f, GL_TRIANGLES, kombiniert,
                     [ship]() -> bool {return ! ship->is_in_hyperspace();}) 
                     );   
 }
 
 void OpenGLRenderer::create(Saucer * saucer, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-    auto [vbo, count] = model_map["saucer"];
+    const Model & model = models[saucer_model];
     float scale = 20.0f; 
     if ( saucer->get_size() == 0 ) {
         scale = 20.0f;
     }
 
-    SquareMatrix4df identitaet = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}};
-                                  
-    views.push_back(std::make_unique<TypedBodyView>(saucer, vbo, shaderProgram, count, scale, GL_TRIANGLES, identitaet));   
+    views.push_back(std::make_unique<TypedBodyView>(saucer, model, placeholder_view.get(), shaderProgram, scale, GL_TRIANGLES, identitaet));   
 }
 
 void OpenGLRenderer::create(Torpedo * torpedo, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-    auto [vbo, count] = model_map["torpedo"];
-    SquareMatrix4df korrektur = {{ 1.0f, 0.0f, 0.0f, 0.0f},
-                                  { 0.0f, 0.0f,-1.0f, 0.0f},
-                                  { 0.0f, 1.0f, 0.0f, 0.0f},
-                                  { 0.0f, 0.0f, 0.0f, 1.0f} };
-    SquareMatrix4df rotZ_minus90 = {{  0.0f, -1.0f, 0.0f, 0.0f},
-                                    {  1.0f,  0.0f, 0.0f, 0.0f},
-                                    {  0.0f,  0.0f, 1.0f, 0.0f},
-                                    {  0.0f,  0.0f, 0.0f, 1.0f} };                        
-    SquareMatrix4df kombiniert = rotZ_minus90 * korrektur;
+    const Model & model = models[torpedo_model];
     
     // Skalierung verdoppelt von 12.0f auf 24.0f
-    views.push_back(std::make_unique<TypedBodyView>(torpedo, vbo, shaderProgram, count, 24.0f, GL_TRIANGLES, kombiniert)); 
+    views.push_back(std::make_unique<TypedBodyView>(torpedo, model, placeholder_view.get(), shaderProgram, 24.0f, GL_TRIANGLES, kombiniert)); 
 }
 
 void OpenGLRenderer::create(Asteroid * asteroid, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-    auto [vbo, count] = model_map["asteroid"];
+    const Model & model = models[asteroid_model];
     float base_scale = 40.0f;
     float scale = (asteroid->get_size() == 3 ? base_scale : ( asteroid->get_size() == 2 ? base_scale*0.5f : base_scale*0.25f ));
 
-    SquareMatrix4df identitaet = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}};
-    
-    views.push_back(std::make_unique<TypedBodyView>(asteroid, vbo, shaderProgram, count, scale, GL_TRIANGLES, identitaet)); 
+    views.push_back(std::make_unique<TypedBodyView>(asteroid, model, placeholder_view.get(), shaderProgram, scale, GL_TRIANGLES, identitaet)); 
 }
 
 void OpenGLRenderer::create(SpaceshipDebris * debris, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-    auto [vbo, count] = model_map["debris"];
+    const Model & model = models[debris_model];
     
-    SquareMatrix4df identitaet = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}};
-    
-    views.push_back(std::make_unique<TypedBodyView>(debris, vbo, shaderProgram, count, 2.0f, GL_TRIANGLES, identitaet,
+    views.push_back(std::make_unique<TypedBodyView>(debris, model, placeholder_view.get(), shaderProgram, 2.0f, GL_TRIANGLES, identitaet,
             []() -> bool {return true;},
             [debris](TypedBodyView * view) -> void { view->set_scale( 2.0f * (SpaceshipDebris::TIME_TO_DELETE - debris->get_time_to_delete()));}));   
 }
 
 void OpenGLRenderer::create(Debris * debris, std::vector< std::unique_ptr<TypedBodyView> > & views) {
-     auto [vbo, count] = model_map["debris"];
-    
-    SquareMatrix4df identitaet = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}};
+     const Model & model = models[debris_model];
 
-    views.push_back(std::make_unique<TypedBodyView>(debris, vbo, shaderProgram, count, 1.0f, GL_TRIANGLES, identitaet,
+    views.push_back(std::make_unique<TypedBodyView>(debris, model, placeholder_view.get(), shaderProgram, 1.0f, GL_TRIANGLES, identitaet,
             []() -> bool {return true;},
             [debris](TypedBodyView * view) -> void { view->set_scale(1.0f * (Debris::TIME_TO_DELETE - debris->get_time_to_delete()));}));   
 }
 
+void OpenGLRenderer::createPlaceholderView() {
+    placeholder_view = std::make_unique<OpenGLView>(models[placeholder_model], shaderProgram, GL_LINE_STRIP);
+}
+
 void OpenGLRenderer::createSpaceShipView() {
-    auto [vbo, count] = model_map["spaceship"];
-    spaceship_view = std::make_unique<OpenGLView>(vbo, shaderProgram, count, GL_TRIANGLES);
+    const Model & model = models[spaceship_model];
+    spaceship_view = std::make_unique<OpenGLView>(model, shaderProgram, GL_TRIANGLES);
 }
 
 void OpenGLRenderer::createDigitViews() {
     for (int i = 0; i < 10; i++ ) {
-        std::string name = "digit_" + std::to_string(i);
-        auto [vbo, count] = model_map[name];
-        digit_views[i] = std::make_unique<OpenGLView>(vbo, shaderProgram, count, GL_LINE_STRIP); // Ziffern sind Linien
+        const Model & model = models[digit_models[i]];
+        digit_views[i] = std::make_unique<OpenGLView>(model, shaderProgram, GL_LINE_STRIP); // Ziffern sind Linien
     }
 }
 
 
-void OpenGLRenderer::renderFreeShips(SquareMatrix4df & matrice) {
+void OpenGLRenderer::renderFreeShips(const SquareMatrix4df & matrice) {
     constexpr float FREE_SHIP_X = 128;
     constexpr float FREE_SHIP_Y = 64;
-    const float PIf = static_cast<float> ( PI );
     Vector2df position = {FREE_SHIP_X, FREE_SHIP_Y};
-    
-    // Rotation damit es nach oben zeigt?
-    SquareMatrix4df rotation = {   { std::cos(-PIf / 2.0f),  std::sin(-PIf / 2.0f), 0.0f, 0.0f},
-                                    {-std::sin(-PIf / 2.0f),  std::cos(-PIf / 2.0f), 0.0f, 0.0f},
-                                    { 0.0f,                 0.0f,                1.0f, 0.0f},
-                                    { 0.0f,                 0.0f,                0.0f, 1.0f}
-                                };
-    // Zusätzliche Skalierung für Anzeige
-    SquareMatrix4df scaleMat = { { 3.0f, 0.0f, 0.0f, 0.0f},
-                                 { 0.0f, 3.0f, 0.0f, 0.0f},
-                                 { 0.0f, 0.0f, 3.0f, 0.0f},
-                                 { 0.0f, 0.0f, 0.0f, 1.0f} };
                                 
     for (int i = 0; i < game.get_no_of_ships(); i++) {
-        SquareMatrix4df  translation= { {1.0f,        0.0f,         0.0f, 0.0f},
-                                        {0.0f,        1.0f,         0.0f, 0.0f},
-                                        {0.0f,        0.0f,         1.0f, 0.0f},
-                                        {position[0], position[1],  0.0f, 1.0f} };
+        // nach oben gedreht (-90 Grad) und dreifach skaliert
+        Affine3df translation_rotation_scale = Affine3df::from_trs({position[0], position[1], 0.0f}, 0.0f, -1.0f, 3.0f);
         
-        SquareMatrix4df render_matrice = matrice * translation * rotation * scaleMat;
-        spaceship_view->render( render_matrice );
+        SquareMatrix4df render_matrice = matrice * translation_rotation_scale.to_matrix();
+        if (!spaceship_view->render( render_matrice, 3.0f * pixels_per_unit() )) {
+            placeholder_view->render( render_matrice );
+        }
         position[0] += 40.0;
     }
 }
 
-void OpenGLRenderer::renderScore(SquareMatrix4df & matrice) {
+void OpenGLRenderer::renderScore(const SquareMatrix4df & matrice) {
     constexpr float SCORE_X = 128 - 48;
     constexpr float SCORE_Y = 48 - 4;
     
@@ -550,12 +598,13 @@ void OpenGLRenderer::create_shader_programs() {
         "out vec3 vNormal;\n"
         "out vec3 vPos;\n"
         "uniform mat4 transform;\n"
+        "uniform mat3 normal_matrix;\n"
         "void main()\n"
         "{\n"
         "   gl_Position = transform * vec4(p, 1.0);\n"
         "   vPos = vec3(transform * vec4(p, 1.0));\n"
-        "   // Transformiere Normale mit der oberen 3x3 der MVP (Näherung für uniforme Rotation)\n"
-        "   vNormal = normalize(mat3(transform) * n);\n" 
+        "   // Normale wird erst im Fragment-Shader normalisiert\n"
+        "   vNormal = normal_matrix * n;\n" 
         "   vColor = vec4(c, 1.0);\n"
         "}\0";
         
@@ -678,7 +727,10 @@ bool OpenGLRenderer::init() {
         glEnable(GL_DEPTH_TEST); 
 
         create_shader_programs();
+        // die Worker parsen bzw. mappen die Modelle, während schon gezeichnet wird
+        asset_loader = std::make_unique<AssetLoader>();
         createVbos();
+        createPlaceholderView();
         createSpaceShipView();
         createDigitViews();
         return true;
@@ -699,18 +751,11 @@ static Vector2df tile_positions [] = {
                          {0.0f, -768.0f} };
 
 void OpenGLRenderer::render() {
-    // transformation to canonical view (Top-Down Ortho-ish)
-    SquareMatrix4df canonical_transform =
-    SquareMatrix4df{
-        { 2.0f / 1024.0f,           0.0f,            0.0f,  0.0f},
-        {       0.0f,     -2.0f / 768.0f,            0.0f,  0.0f},
-        {       0.0f,               0.0f,  2.0f / 1024.0f,  0.0f}, 
-        {      -1.0f,               1.0f,           0.0f,  1.0f}  
-    };
-                                                 
     glClearColor ( 0.0, 0.0, 0.0, 1.0 );
     glClear ( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
     
+    upload_loaded_models();
+
     // remove all views for typed bodies that have to be deleted 
     erase_if(views, []( std::unique_ptr<TypedBodyView> & view) { return view->get_typed_body()->is_marked_for_deletion();}); 
 
@@ -734,12 +779,7 @@ void OpenGLRenderer::render() {
         }
     }
 
-    SquareMatrix4df scroll_transform = SquareMatrix4df{
-        {1.0f, 0.0f, 0.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f, 0.0f},
-        {0.0f, 0.0f, 1.0f, 0.0f},
-        {0.0f, 0.0f, 0.0f, 1.0f}
-    };
+    SquareMatrix4df scroll_transform = identitaet;
     if (game.ship_exists() && game.get_ship() != nullptr) {
         Vector2df ship_pos = game.get_ship()->get_position();
         scroll_transform = SquareMatrix4df{
@@ -759,7 +799,7 @@ void OpenGLRenderer::render() {
         };
         SquareMatrix4df world = canonical_transform * scroll_transform * tile_transform;
         for (auto & view : views) {
-            view->render(world);
+            view->render(world, pixels_per_unit());
         }
     }
     renderFreeShips(canonical_transform);
@@ -768,11 +808,18 @@ void OpenGLRenderer::render() {
     SDL_GL_SwapWindow(window);
 }
 
+// canonical_transform bildet die Spielwelt mit 1024 Einheiten Breite auf das Fenster ab
+float OpenGLRenderer::pixels_per_unit() const {
+    return window_width / 1024.0f;
+}
+
 void OpenGLRenderer::exit() {
+    // wartet nur auf die Dateien, die gerade geladen werden
+    asset_loader.reset();
     views.clear();
-    for(auto const& [name, val] : model_map) {
-        glDeleteBuffers(1, &val.first);
-    }
+    // die Modelle teilen sich Puffer (debris und asteroid), daher über vbo_list löschen
+    glDeleteBuffers(vbo_list.size(), vbo_list.data());
+    vbo_list.clear();
     SDL_GL_DeleteContext(context);
     SDL_DestroyWindow( window );
     SDL_Quit();
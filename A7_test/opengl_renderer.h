@@ -6,42 +6,70 @@
 #include <SDL2/SDL.h>
 #include <iostream>
 #include "matrix.h"
+#include "quaternion.h"
 #include "physics.h"
 #include "game.h"
 #include "renderer.h"
 #include "debug.h"
 #include "wavefront.h" // Add wavefront include
+#include "asset_loader.h"
+#include "registry.h"
 #include <array>
 #include <vector>
 #include <memory>
 #include <map>
+#include <limits>
+
+// ein VBO mit Pos(3), Normale(3), Farbe(3) je Vertex, optional mit Indexpuffer
+// vbo == 0: das Modell wird noch geladen
+struct Model {
+  // eine vereinfachte Detailstufe: die Indizes [first, first + count) im Indexpuffer,
+  // error ist ihre größte Abweichung vom Modell in Modelleinheiten
+  struct Lod {
+    size_t first;
+    size_t count;
+    float error;
+  };
+
+  GLuint vbo = 0;
+  GLuint ebo = 0;   // 0: die Vertices werden der Reihe nach gezeichnet
+  size_t count = 0; // Anzahl der Vertices bzw. der Indizes
+  std::vector<Lod> lods; // mit steigendem error und weniger Dreiecken
+};
 
 // stores information on how to render a specific vertex buffer (vbo)
 // the vob's layout used by the shaderProgram is hard coded into the render() method.
 class OpenGLView {
 protected:
   unsigned int shaderProgram;
-  size_t vertices_size;
+  const Model * model; // muss die View überleben, wird beim Hochladen eines geladenen Modells ersetzt
   GLuint mode;
-  GLuint vao;
+  GLuint vao = 0;      // 0: das Modell wurde noch nicht hochgeladen
+  void create_vao();
 public:
-  OpenGLView(GLuint vbo, unsigned int shaderProgram, size_t vertices_size, GLuint mode = GL_LINE_LOOP);  
+  OpenGLView(const Model & model, unsigned int shaderProgram, GLuint mode = GL_LINE_LOOP);  
 
   ~OpenGLView();
     
-  void render( SquareMatrix<float,4> & matrice);  
+  // pixel_pro_einheit: Größe einer Modelleinheit auf dem Bildschirm, danach wird die gröbste Detailstufe
+  // gewählt, deren Abweichung höchstens ein Pixel beträgt (ohne Angabe wird das ganze Modell gezeichnet)
+  // false, wenn das Modell noch geladen wird und nichts gezeichnet wurde
+  bool render( SquareMatrix<float,4> & matrice, float pixel_pro_einheit = std::numeric_limits<float>::infinity());  
 };
 
 
 class TypedBodyView : public OpenGLView {
   TypedBody * typed_body;    // the body that is rendered by this view
   float scale;
-  SquareMatrix4df achsen_korrektur; // Zusätzliche Rotation/Transformation für das Modell
+  Affine3df achsen_korrektur; // Zusätzliche Rotation/Transformation für das Modell
+  float cached_angle = 0.0f; // Winkel, zu dem rotation_z gehört
+  Quaterniondf rotation_z;    // Drehung um cached_angle in der x/y Ebene
+  OpenGLView * platzhalter;   // wird gezeichnet, bis das Modell geladen ist (nullptr: nichts)
   std::function<bool()> draw; // view is rendered iff draw() returns true
   std::function<void(TypedBodyView *)> modify; // a callback which my change this TypedBodyView, for instance, for animations
-  SquareMatrix4df create_object_transformation(Vector2df direction, float angle, float scale);
+  Affine3df create_object_transformation(Vector2df direction, float angle, Quaterniondf orientation, float scale);
 public:
-  TypedBodyView(TypedBody * typed_body, GLuint vbo, unsigned int shaderProgram, size_t vertices_size, float scale = 1.0f, GLuint mode = GL_LINE_LOOP,
+  TypedBodyView(TypedBody * typed_body, const Model & model, OpenGLView * platzhalter, unsigned int shaderProgram, float scale = 1.0f, GLuint mode = GL_LINE_LOOP,
                SquareMatrix4df achsen_korrektur = {{1.0f,0.0f,0.0f,0.0f}, {0.0f,1.0f,0.0f,0.0f}, {0.0f,0.0f,1.0f,0.0f}, {0.0f,0.0f,0.0f,1.0f}},
                std::function<bool()> draw = []() -> bool {return true;},
                std::function<void(TypedBodyView *)> modify = [](TypedBodyView *) -> void {});
@@ -49,7 +77,8 @@ public:
   // Gibt eine 4x4 Transformationsmatrix zurück, die ein Objekt gegen den Uhrzeigersinn um den gegebenen Winkel in der x/y Ebene rotiert,
   // es skaliert und in die gegebene Richtung verschiebt
  
-  void render( SquareMatrix<float,4> & world) ;
+  // pixel_pro_welteinheit: Bildschirmgröße einer Einheit der Spielwelt, mit scale ergibt sich daraus die Detailstufe
+  void render( SquareMatrix<float,4> & world, float pixel_pro_welteinheit = 1.0f) ;
   
  TypedBody * get_typed_body();
 
@@ -70,13 +99,24 @@ class OpenGLRenderer : public Renderer {
   unsigned int shaderProgram;
   std::vector< std::unique_ptr<TypedBodyView > > views;
   
-  // Map speichert Name -> {VBO ID, Anzahl Vertices}
-  std::map<std::string, std::pair<GLuint, size_t>> model_map; 
+  // die Modelle unter ihren Namen, beim Start interniert: create() und render() greifen nur
+  // über die Handles zu, ohne Namen zu vergleichen
+  Registry<Model> models;
+  Handle<Model> spaceship_model, asteroid_model, torpedo_model, saucer_model, debris_model, placeholder_model;
+  std::array<Handle<Model>, 10> digit_models;
   std::vector<GLuint> vbo_list; // Zum Aufräumen
 
+  // die OBJ-Dateien werden in Worker-Threads geladen, render() lädt die fertigen hoch
+  std::unique_ptr<AssetLoader> asset_loader;
+  std::multimap<std::string, Handle<Model>> ladende_modelle; // OBJ-Datei -> Modell
+  std::unique_ptr<OpenGLView> placeholder_view;
+
   std::unique_ptr<OpenGLView> spaceship_view;
   std::array< std::unique_ptr<OpenGLView>, 10> digit_views;
   void createVbos();
+  Handle<Model> load_model(const std::string & name, const std::string & dateiname);
+  void upload_loaded_models();
+  void createPlaceholderView();
   void createSpaceShipView();
   void createDigitViews();
   void create(Spaceship * ship, std::vector< std::unique_ptr<TypedBodyView> > & views); 
@@ -85,8 +125,9 @@ class OpenGLRenderer : public Renderer {
   void create(Saucer * saucer, std::vector< std::unique_ptr<TypedBodyView> > & views);
   void create(SpaceshipDebris * debris, std::vector< std::unique_ptr<TypedBodyView> > & views);
   void create(Debris * debris, std::vector< std::unique_ptr<TypedBodyView> > & views);
-  void renderFreeShips(SquareMatrix4df & matrice);
-  void renderScore(SquareMatrix4df & matrice);
+  void renderFreeShips(const SquareMatrix4df & matrice);
+  void renderScore(const SquareMatrix4df & matrice);
+  float pixels_per_unit() const; // Pixel je Einheit der Spielwelt
   void create_shader_programs();
 public:
   OpenGLRenderer(Game & game, std::string title, int window_width = 1024, int window_height = 768)
@@ -8,3 +8,7 @@ template class Physics<float, 2u, BoundingVolumeCircle<float, 2>>;
 template class Body<float, 2u, BoundingVolumeHyperRectangle<float, 2>>;
 template class Physics<float, 2u, BoundingVolumeHyperRectangle<float, 2>>;
 
+template class BoundingVolumeCircle<double, 2>;
+template class Body<double, 2u, BoundingVolumeCircle<double, 2>>;
+template class Physics<double, 2u, BoundingVolumeCircle<double, 2>>;
+
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "math.h"
+#include "quaternion.h"
 #include "timer.h"
 #include "geometry.h"
 
@@ -60,6 +61,10 @@ protected:
   FLOAT_TYPE max_velocity;
   FLOAT_TYPE min_velocity;
   FLOAT_TYPE angle;
+  // optional 3D orientation (identity unless set), applied before the angle in the x/y-plane
+  Quaternion<FLOAT_TYPE> orientation;
+  // rotation axis * radians per second, the orientation is integrated in move()
+  Vector<FLOAT_TYPE, 3> angular_velocity;
 
   std::function<void(Body<FLOAT_TYPE, N, BV> *, FLOAT_TYPE)> fix; // fix object values after movement
 
@@ -100,6 +105,14 @@ public:
   bool is_marked_for_deletion() const;
   
   FLOAT_TYPE get_angle() const;
+
+  Quaternion<FLOAT_TYPE> get_orientation() const;
+
+  void set_orientation(Quaternion<FLOAT_TYPE> orientation);
+
+  Vector<FLOAT_TYPE, 3> get_angular_velocity() const;
+
+  void set_angular_velocity(Vector<FLOAT_TYPE, 3> angular_velocity);
   
   void set_time_to_delete(FLOAT_TYPE time_to_delete);
   
@@ -191,4 +204,10 @@ typedef BoundingVolumeHyperRectangle<float, 2u> Rectangle2df;
 typedef Body<float, 2u, Rectangle2df> BodyRect2df;
 typedef Physics<float, 2u, Rectangle2df> PhysicsRect2df;
 
+// Positionen und Geschwindigkeiten in double fuer grosse Welten, gerendert wird mit
+//   relative_to(position, kamera) in float
+typedef BoundingVolumeCircle<double, 2u> BoundingVolume2dd;
+typedef Body<double, 2u, BoundingVolume2dd> Body2dd;
+typedef Physics<double, 2u, BoundingVolume2dd> Physics2dd;
+
 #endif
@@ -2,6 +2,9 @@
 #include <cassert>
 #include "debug.h"
 #include <algorithm>
+#ifdef MATH_EXPRESSION_TEMPLATES
+#include "vector_expression.h"
+#endif
 
 template<class FLOAT_TYPE, size_t N>
 BoundingVolumeCircle<FLOAT_TYPE, N>::BoundingVolumeCircle(Vector<FLOAT_TYPE,N> position, FLOAT_TYPE radius) 
@@ -77,7 +80,13 @@ Body<FLOAT_TYPE, N, BV>::Body(
  
 template<class FLOAT_TYPE, size_t N, class BV>
 void Body<FLOAT_TYPE, N, BV>::move(FLOAT_TYPE seconds) {
+#ifdef MATH_EXPRESSION_TEMPLATES
+  set_position( expr::evaluate(expr::lazy(get_position()) + seconds * expr::lazy(velocity)) );
+#else
   set_position( get_position() +  seconds * velocity);
+#endif
+  // ohne Winkelgeschwindigkeit kehrt integrate sofort zurück
+  orientation.integrate(angular_velocity, seconds);
   delete_counter.tick(seconds);
   fix(this, seconds);
 }
@@ -91,11 +100,14 @@ void Body<FLOAT_TYPE, N, BV>::turn(FLOAT_TYPE angle, FLOAT_TYPE seconds) {
 
 template<class FLOAT_TYPE, size_t N, class BV>
 void Body<FLOAT_TYPE, N, BV>::set_velocity(Vector<FLOAT_TYPE, N> velocity) {
-  if (velocity.length() > max_velocity) {
-    velocity = (1.0f / velocity.length()) * max_velocity  * velocity;
+  // Länge nur einmal berechnen, wird für jeden Körper in jedem Frame aufgerufen
+  FLOAT_TYPE length = velocity.length(FastMath{});
+  if (length > max_velocity) {
+    velocity = (max_velocity / length) * velocity;
+    length = max_velocity;
   }
-  if (velocity.length() < min_velocity) {
-    velocity = (min_velocity / velocity.length()) * velocity;
+  if (length < min_velocity) {
+    velocity = (min_velocity / length) * velocity;
   }
   this->velocity = velocity;
 }
@@ -103,7 +115,12 @@ void Body<FLOAT_TYPE, N, BV>::set_velocity(Vector<FLOAT_TYPE, N> velocity) {
 template<class FLOAT_TYPE, size_t N, class BV>
 void Body<FLOAT_TYPE, N, BV>::accelerate(FLOAT_TYPE acceleration, FLOAT_TYPE seconds) {
   if (N >= 2) {
-    Vector<FLOAT_TYPE, N> velocity = this->velocity + seconds * acceleration * Vector<FLOAT_TYPE,N>{ std::cos(angle), std::sin(angle) };   
+#ifdef MATH_EXPRESSION_TEMPLATES
+    const Vector<FLOAT_TYPE, N> direction(angle, FastMath{});
+    Vector<FLOAT_TYPE, N> velocity = expr::evaluate(expr::lazy(this->velocity) + seconds * acceleration * expr::lazy(direction));
+#else
+    Vector<FLOAT_TYPE, N> velocity = this->velocity + seconds * acceleration * Vector<FLOAT_TYPE,N>(angle, FastMath{});
+#endif
     set_velocity(velocity);
   }
 }
@@ -144,6 +161,26 @@ FLOAT_TYPE Body<FLOAT_TYPE, N, BV>::get_angle() const {
   return angle;
 }
 
+template<class FLOAT_TYPE, size_t N, class BV>
+Quaternion<FLOAT_TYPE> Body<FLOAT_TYPE, N, BV>::get_orientation() const {
+  return orientation;
+}
+
+template<class FLOAT_TYPE, size_t N, class BV>
+void Body<FLOAT_TYPE, N, BV>::set_orientation(Quaternion<FLOAT_TYPE> orientation) {
+  this->orientation = orientation;
+}
+
+template<class FLOAT_TYPE, size_t N, class BV>
+Vector<FLOAT_TYPE, 3> Body<FLOAT_TYPE, N, BV>::get_angular_velocity() const {
+  return angular_velocity;
+}
+
+template<class FLOAT_TYPE, size_t N, class BV>
+void Body<FLOAT_TYPE, N, BV>::set_angular_velocity(Vector<FLOAT_TYPE, 3> angular_velocity) {
+  this->angular_velocity = angular_velocity;
+}
+
 template<class FLOAT_TYPE, size_t N, class BV>
 void Body<FLOAT_TYPE, N, BV>::set_time_to_delete(FLOAT_TYPE time_to_delete) {
   time_to_delete = std::max(time_to_delete, static_cast<FLOAT_TYPE>(0.0));
@@ -0,0 +1,53 @@
+#include "physics.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+// Benchmark der Bewegungsschleife (Body::move und Body::accelerate)
+// physics_benchmark nutzt die normalen Vector-Operatoren, physics_benchmark_et wird mit
+//   MATH_EXPRESSION_TEMPLATES uebersetzt und nutzt die Expression Templates aus vector_expression.h
+// jeweils mit float (Body2df) und double (Body2dd, Mischbetrieb fuer grosse Welten)
+
+namespace {
+
+template <class BODY, class BV, class FLOAT>
+std::vector< std::unique_ptr<BODY> > create_bodies(size_t count) {
+  std::vector< std::unique_ptr<BODY> > bodies;
+  for (size_t i = 0; i < count; i++) {
+    FLOAT f = static_cast<FLOAT>(i);
+    bodies.push_back(std::make_unique<BODY>(BV({f, 2 * f}, 1),
+                                            Vector<FLOAT, 2u>{f / 2, -f}, 1e6, 0.0, f / 100));
+  }
+  return bodies;
+}
+
+template <class BODY, class BV, class FLOAT>
+void BM_Move(benchmark::State & state) {
+  auto bodies = create_bodies<BODY, BV, FLOAT>(state.range(0));
+  for (auto _ : state) {
+    for (auto & body : bodies) {
+      body->move(0.016);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Move<Body2df, BoundingVolume2df, float>)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_Move<Body2dd, BoundingVolume2dd, double>)->Arg(1000)->Arg(100000);
+
+template <class BODY, class BV, class FLOAT>
+void BM_AccelerateAndMove(benchmark::State & state) {
+  auto bodies = create_bodies<BODY, BV, FLOAT>(state.range(0));
+  for (auto _ : state) {
+    for (auto & body : bodies) {
+      body->accelerate(0.5, 0.016);
+      body->move(0.016);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AccelerateAndMove<Body2df, BoundingVolume2df, float>)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_AccelerateAndMove<Body2dd, BoundingVolume2dd, double>)->Arg(1000)->Arg(100000);
+
+}
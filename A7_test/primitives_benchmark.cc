@@ -0,0 +1,325 @@
+#include "math.h"
+#include "matrix.h"
+#include "geometry.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// Microbenchmarks fuer Vector, SquareMatrix und die Schnitttests aus geometry.h,
+//   jeweils fuer float und double mit N = 2, 3, 4 (Kreuzprodukt und Dreiecke nur N = 3)
+// Jeder Benchmark arbeitet auf COUNT zufaelligen Werten (fester Startwert), damit der Compiler
+//   nichts vorab berechnen kann und die Sprungvorhersage realistisch bleibt.
+// Die Ergebnisse als JSON schreibt das Target primitives_benchmark_json
+//   (build/primitives_benchmark.json), zwei Laeufe vergleicht z.B. compare.py benchmarks alt.json neu.json
+
+namespace {
+
+const size_t COUNT = 1024u;
+
+template <class FLOAT, size_t N>
+std::vector< Vector<FLOAT, N> > create_vectors(FLOAT minimum, FLOAT maximum, unsigned int seed = 42u) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<FLOAT> distribution(minimum, maximum);
+  std::vector< Vector<FLOAT, N> > vectors(COUNT);
+  for (Vector<FLOAT, N> & v : vectors) {
+    for (size_t i = 0; i < N; i++) {
+      v[i] = distribution(generator);
+    }
+  }
+  return vectors;
+}
+
+// nahe an der Einheitsmatrix, damit die Werte bei wiederholter Anwendung nicht wachsen
+template <class FLOAT, size_t N>
+SquareMatrix<FLOAT, N> create_matrix() {
+  SquareMatrix<FLOAT, N> matrix;
+  for (size_t column = 0; column < N; column++) {
+    for (size_t row = 0; row < N; row++) {
+      matrix.at(row, column) = (row == column ? 0.9 : 0.0) + 0.05 * (static_cast<FLOAT>(row) - static_cast<FLOAT>(column));
+    }
+  }
+  return matrix;
+}
+
+// Vector
+
+template <class FLOAT, size_t N>
+void BM_VectorAdd(benchmark::State & state) {
+  auto a = create_vectors<FLOAT, N>(-1, 1, 1u);
+  auto b = create_vectors<FLOAT, N>(-1, 1, 2u);
+  std::vector< Vector<FLOAT, N> > result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = a[i] + b[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT, size_t N>
+void BM_VectorScaleAndSubtract(benchmark::State & state) {
+  auto a = create_vectors<FLOAT, N>(-1, 1, 1u);
+  auto b = create_vectors<FLOAT, N>(-1, 1, 2u);
+  std::vector< Vector<FLOAT, N> > result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = a[i] - static_cast<FLOAT>(0.5) * b[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT, size_t N>
+void BM_ScalarProduct(benchmark::State & state) {
+  auto a = create_vectors<FLOAT, N>(-1, 1, 1u);
+  auto b = create_vectors<FLOAT, N>(-1, 1, 2u);
+  for (auto _ : state) {
+    FLOAT sum = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+      sum += a[i] * b[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT, size_t N>
+void BM_Normalize(benchmark::State & state) {
+  const auto vectors = create_vectors<FLOAT, N>(1, 2);
+  std::vector< Vector<FLOAT, N> > result(COUNT);
+  for (auto _ : state) {
+    result = vectors;
+    for (Vector<FLOAT, N> & v : result) {
+      v.normalize();
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT>
+void BM_CrossProduct(benchmark::State & state) {
+  auto a = create_vectors<FLOAT, 3u>(-1, 1, 1u);
+  auto b = create_vectors<FLOAT, 3u>(-1, 1, 2u);
+  std::vector< Vector<FLOAT, 3u> > result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = a[i].cross_product(b[i]);
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+// SquareMatrix
+
+template <class FLOAT, size_t N>
+void BM_MatrixVector(benchmark::State & state) {
+  const SquareMatrix<FLOAT, N> matrix = create_matrix<FLOAT, N>();
+  auto vectors = create_vectors<FLOAT, N>(-1, 1);
+  std::vector< Vector<FLOAT, N> > result(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 0; i < COUNT; i++) {
+      result[i] = matrix * vectors[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT, size_t N>
+void BM_MatrixMatrix(benchmark::State & state) {
+  const SquareMatrix<FLOAT, N> matrix = create_matrix<FLOAT, N>();
+  SquareMatrix<FLOAT, N> product = matrix;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(product);
+    product = product * matrix;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// geometry.h: je ein Test pro Paar aufeinanderfolgender Objekte, etwa die Haelfte schneidet sich
+
+template <class FLOAT, size_t N>
+std::vector< AxisAlignedBoundingBox<FLOAT, N> > create_boxes() {
+  auto centers = create_vectors<FLOAT, N>(-10, 10, 1u);
+  auto half_edge_lengths = create_vectors<FLOAT, N>(1, 6, 2u);
+  std::vector< AxisAlignedBoundingBox<FLOAT, N> > boxes;
+  for (size_t i = 0; i < COUNT; i++) {
+    boxes.emplace_back(centers[i], half_edge_lengths[i]);
+  }
+  return boxes;
+}
+
+template <class FLOAT, size_t N>
+void BM_AABBIntersects(benchmark::State & state) {
+  auto boxes = create_boxes<FLOAT, N>();
+  for (auto _ : state) {
+    size_t hits = 0;
+    for (size_t i = 1; i < COUNT; i++) {
+      hits += boxes[i - 1].intersects(boxes[i]);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+
+template <class FLOAT, size_t N>
+void BM_AABBMovingIntersects(benchmark::State & state) {
+  auto boxes = create_boxes<FLOAT, N>();
+  auto directions = create_vectors<FLOAT, N>(-5, 5, 3u);
+  for (auto _ : state) {
+    size_t hits = 0;
+    for (size_t i = 1; i < COUNT; i++) {
+      hits += boxes[i - 1].intersects(boxes[i], directions[i]);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+
+template <class FLOAT, size_t N>
+void BM_AABBSweepIntersects(benchmark::State & state) {
+  auto boxes = create_boxes<FLOAT, N>();
+  auto directions = create_vectors<FLOAT, N>(-5, 5, 3u);
+  std::vector< Vector<FLOAT, N> > normals(COUNT);
+  for (auto _ : state) {
+    for (size_t i = 1; i < COUNT; i++) {
+      normals[i] = boxes[i - 1].sweep_intersects(boxes[i], directions[i]);
+    }
+    benchmark::DoNotOptimize(normals.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+
+template <class FLOAT, size_t N>
+std::vector< Sphere<FLOAT, N> > create_spheres() {
+  auto centers = create_vectors<FLOAT, N>(-10, 10, 1u);
+  auto radii = create_vectors<FLOAT, 1u>(1, 8, 2u);
+  std::vector< Sphere<FLOAT, N> > spheres;
+  for (size_t i = 0; i < COUNT; i++) {
+    spheres.emplace_back(centers[i], radii[i][0]);
+  }
+  return spheres;
+}
+
+template <class FLOAT, size_t N>
+std::vector< Ray<FLOAT, N> > create_rays() {
+  auto origins = create_vectors<FLOAT, N>(-20, 20, 3u);
+  auto targets = create_vectors<FLOAT, N>(-2, 2, 4u);
+  std::vector< Ray<FLOAT, N> > rays(COUNT);
+  for (size_t i = 0; i < COUNT; i++) {
+    rays[i].origin = origins[i];
+    rays[i].direction = targets[i] - origins[i];
+    rays[i].direction.normalize();
+  }
+  return rays;
+}
+
+template <class FLOAT, size_t N>
+void BM_SphereIntersects(benchmark::State & state) {
+  auto spheres = create_spheres<FLOAT, N>();
+  for (auto _ : state) {
+    size_t hits = 0;
+    for (size_t i = 1; i < COUNT; i++) {
+      hits += spheres[i - 1].intersects(spheres[i]);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * (COUNT - 1));
+}
+
+template <class FLOAT, size_t N>
+void BM_SphereRayIntersects(benchmark::State & state) {
+  auto spheres = create_spheres<FLOAT, N>();
+  auto rays = create_rays<FLOAT, N>();
+  for (auto _ : state) {
+    FLOAT sum = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+      sum += spheres[i].intersects(rays[i]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT>
+std::vector< Triangle<FLOAT, 3u> > create_triangles() {
+  auto a = create_vectors<FLOAT, 3u>(-3, 3, 5u);
+  auto b = create_vectors<FLOAT, 3u>(-3, 3, 6u);
+  auto c = create_vectors<FLOAT, 3u>(-3, 3, 7u);
+  std::vector< Triangle<FLOAT, 3u> > triangles;
+  for (size_t i = 0; i < COUNT; i++) {
+    triangles.emplace_back(a[i], b[i], c[i]);
+  }
+  return triangles;
+}
+
+template <class FLOAT>
+void BM_TriangleIntersects(benchmark::State & state) {
+  auto triangles = create_triangles<FLOAT>();
+  auto rays = create_rays<FLOAT, 3u>();
+  for (auto _ : state) {
+    size_t hits = 0;
+    Vector<FLOAT, 3u> normal, intersection;
+    FLOAT u, v, t;
+    for (size_t i = 0; i < COUNT; i++) {
+      hits += triangles[i].intersects(rays[i], normal, intersection, u, v, t);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+template <class FLOAT>
+void BM_TriangleIntersectsContext(benchmark::State & state) {
+  auto triangles = create_triangles<FLOAT>();
+  auto rays = create_rays<FLOAT, 3u>();
+  for (auto _ : state) {
+    size_t hits = 0;
+    Intersection_Context<FLOAT, 3u> context;
+    for (size_t i = 0; i < COUNT; i++) {
+      hits += triangles[i].intersects(rays[i], context);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+}
+
+#define BENCHMARK_ALL_TYPES(function) \
+  BENCHMARK_TEMPLATE(function, float, 2u); \
+  BENCHMARK_TEMPLATE(function, float, 3u); \
+  BENCHMARK_TEMPLATE(function, float, 4u); \
+  BENCHMARK_TEMPLATE(function, double, 2u); \
+  BENCHMARK_TEMPLATE(function, double, 3u); \
+  BENCHMARK_TEMPLATE(function, double, 4u)
+
+BENCHMARK_ALL_TYPES(BM_VectorAdd);
+BENCHMARK_ALL_TYPES(BM_VectorScaleAndSubtract);
+BENCHMARK_ALL_TYPES(BM_ScalarProduct);
+BENCHMARK_ALL_TYPES(BM_Normalize);
+BENCHMARK_TEMPLATE(BM_CrossProduct, float);
+BENCHMARK_TEMPLATE(BM_CrossProduct, double);
+
+BENCHMARK_ALL_TYPES(BM_MatrixVector);
+BENCHMARK_ALL_TYPES(BM_MatrixMatrix);
+
+BENCHMARK_ALL_TYPES(BM_AABBIntersects);
+BENCHMARK_ALL_TYPES(BM_AABBMovingIntersects);
+BENCHMARK_ALL_TYPES(BM_AABBSweepIntersects);
+BENCHMARK_ALL_TYPES(BM_SphereIntersects);
+BENCHMARK_ALL_TYPES(BM_SphereRayIntersects);
+BENCHMARK_TEMPLATE(BM_TriangleIntersects, float);
+BENCHMARK_TEMPLATE(BM_TriangleIntersects, double);
+BENCHMARK_TEMPLATE(BM_TriangleIntersectsContext, float);
+BENCHMARK_TEMPLATE(BM_TriangleIntersectsContext, double);
+
+}
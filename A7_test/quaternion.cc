@@ -0,0 +1,7 @@
+#include "quaternion.h"
+
+template struct Quaternion<float>;
+
+template Quaternion<float> operator*(const Quaternion<float> factor1, const Quaternion<float> factor2);
+template Quaternion<float> nlerp(const Quaternion<float> from, Quaternion<float> to, float t);
+template Quaternion<float> slerp(const Quaternion<float> from, Quaternion<float> to, float t);
@@ -0,0 +1,194 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "math.h"
+#include "matrix.h"
+
+// Einheitsquaternion fuer Drehungen im Raum
+// Die Komponenten werden als (x, y, z, w) gespeichert: x, y, z ist der Vektorteil, w der Skalarteil.
+//   Fuer float passt das Quaternion damit direkt in ein SIMD-Register (siehe quaternion_simd.h).
+// Das Produkt q1 * q2 dreht zuerst mit q2, dann mit q1 (wie bei Matrizen).
+template <class FLOAT>
+struct Quaternion {
+  Vector<FLOAT, 4> components;
+
+  // erstellt die Identitaet (keine Drehung)
+  constexpr Quaternion();
+
+  constexpr Quaternion(FLOAT x, FLOAT y, FLOAT z, FLOAT w);
+
+  // Drehung um die normierte Achse axis um angle (in Radiant, gegen den Uhrzeigersinn)
+  template <MathPolicy MATH = StdMath>
+  static Quaternion from_axis_angle(const Vector<FLOAT, 3> axis, FLOAT angle, MATH = {});
+
+  // Gibt das konjugierte Quaternion zurück, bei Einheitsquaternionen die inverse Drehung
+  constexpr Quaternion conjugate() const;
+
+  // normiert das Quaternion auf die Laenge 1
+  void normalize();
+
+  // dreht den Punkt point
+  constexpr Vector<FLOAT, 3> rotate(const Vector<FLOAT, 3> point) const;
+
+  // Gibt die zugehoerige Drehmatrix zurück
+  constexpr SquareMatrix<FLOAT, 3> to_matrix() const;
+
+  // Gibt die affine Transformation translation * rotation * scaling zurück
+  //   (wie Affine3::from_trs, aber mit beliebiger Drehachse)
+  constexpr Affine3<FLOAT> to_affine(const Vector<FLOAT, 3> position, FLOAT scale) const;
+
+  // dreht mit der Winkelgeschwindigkeit angular_velocity (Drehachse * rad/s, im Weltkoordinatensystem)
+  //   fuer seconds Sekunden weiter; fuer jeden Koerper in jedem Frame aufgerufen, daher mit FastMath
+  void integrate(const Vector<FLOAT, 3> angular_velocity, FLOAT seconds);
+
+  // Gibt die Hintereinanderausfuehrung zurück, zuerst factor2, dann factor1
+  template <class F>
+  friend constexpr Quaternion<F> operator*(const Quaternion<F> factor1, const Quaternion<F> factor2);
+};
+
+// normierte lineare Interpolation, schnell, aber ohne konstante Winkelgeschwindigkeit
+template <class FLOAT>
+Quaternion<FLOAT> nlerp(const Quaternion<FLOAT> from, Quaternion<FLOAT> to, FLOAT t);
+
+// spharische lineare Interpolation mit konstanter Winkelgeschwindigkeit
+template <class FLOAT>
+Quaternion<FLOAT> slerp(const Quaternion<FLOAT> from, Quaternion<FLOAT> to, FLOAT t);
+
+template <class FLOAT>
+constexpr Quaternion<FLOAT>::Quaternion() {
+  components[3] = 1;
+}
+
+template <class FLOAT>
+constexpr Quaternion<FLOAT>::Quaternion(FLOAT x, FLOAT y, FLOAT z, FLOAT w) {
+  components[0] = x;
+  components[1] = y;
+  components[2] = z;
+  components[3] = w;
+}
+
+template <class FLOAT>
+template <MathPolicy MATH>
+Quaternion<FLOAT> Quaternion<FLOAT>::from_axis_angle(const Vector<FLOAT, 3> axis, FLOAT angle, MATH) {
+  FLOAT sin_half, cos_half;
+  MATH::sincos(angle / 2, sin_half, cos_half);
+  return {axis[0] * sin_half, axis[1] * sin_half, axis[2] * sin_half, cos_half};
+}
+
+template <class FLOAT>
+constexpr Quaternion<FLOAT> Quaternion<FLOAT>::conjugate() const {
+  return {-components[0], -components[1], -components[2], components[3]};
+}
+
+template <class FLOAT>
+void Quaternion<FLOAT>::normalize() {
+  components.normalize();
+}
+
+// v + 2w (u x v) + 2 u x (u x v) mit u = (x, y, z); Kreuzprodukt mit der ueblichen Vorzeichenkonvention
+//   (Vector::cross_product weicht davon ab)
+template <class FLOAT>
+constexpr Vector<FLOAT, 3> Quaternion<FLOAT>::rotate(const Vector<FLOAT, 3> point) const {
+  const FLOAT x = components[0], y = components[1], z = components[2], w = components[3];
+  const FLOAT tx = 2 * (y * point[2] - z * point[1]);
+  const FLOAT ty = 2 * (z * point[0] - x * point[2]);
+  const FLOAT tz = 2 * (x * point[1] - y * point[0]);
+  Vector<FLOAT, 3> result;
+  result[0] = point[0] + w * tx + (y * tz - z * ty);
+  result[1] = point[1] + w * ty + (z * tx - x * tz);
+  result[2] = point[2] + w * tz + (x * ty - y * tx);
+  return result;
+}
+
+template <class FLOAT>
+constexpr SquareMatrix<FLOAT, 3> Quaternion<FLOAT>::to_matrix() const {
+  const FLOAT x = components[0], y = components[1], z = components[2], w = components[3];
+  SquareMatrix<FLOAT, 3> result;
+  result.at(0, 0) = 1 - 2 * (y * y + z * z);
+  result.at(0, 1) = 2 * (x * y - z * w);
+  result.at(0, 2) = 2 * (x * z + y * w);
+  result.at(1, 0) = 2 * (x * y + z * w);
+  result.at(1, 1) = 1 - 2 * (x * x + z * z);
+  result.at(1, 2) = 2 * (y * z - x * w);
+  result.at(2, 0) = 2 * (x * z - y * w);
+  result.at(2, 1) = 2 * (y * z + x * w);
+  result.at(2, 2) = 1 - 2 * (x * x + y * y);
+  return result;
+}
+
+template <class FLOAT>
+constexpr Affine3<FLOAT> Quaternion<FLOAT>::to_affine(const Vector<FLOAT, 3> position, FLOAT scale) const {
+  SquareMatrix<FLOAT, 3> linear = to_matrix();
+  for (size_t col = 0; col < 3; ++col) {
+    for (size_t row = 0; row < 3; ++row) {
+      linear.at(row, col) *= scale;
+    }
+  }
+  return Affine3<FLOAT>(linear, position);
+}
+
+template <class FLOAT>
+void Quaternion<FLOAT>::integrate(const Vector<FLOAT, 3> angular_velocity, FLOAT seconds) {
+  const FLOAT square_of_speed = angular_velocity.square_of_length();
+  if (square_of_speed == 0) {
+    return;
+  }
+  // exakte Drehung fuer konstante Winkelgeschwindigkeit, danach normieren gegen Rundungsfehler
+  const FLOAT inverse_speed = FastMath::rsqrt(square_of_speed);
+  const Quaternion<FLOAT> delta = from_axis_angle(inverse_speed * angular_velocity,
+                                                  square_of_speed * inverse_speed * seconds, FastMath{});
+  *this = delta * *this;
+  normalize();
+}
+
+// Summationsreihenfolge wie in quaternion_simd.h, die Ergebnisse sind dort bitgenau gleich
+template <class F>
+constexpr Quaternion<F> operator*(const Quaternion<F> factor1, const Quaternion<F> factor2) {
+  const F x1 = factor1.components[0], y1 = factor1.components[1], z1 = factor1.components[2], w1 = factor1.components[3];
+  const F x2 = factor2.components[0], y2 = factor2.components[1], z2 = factor2.components[2], w2 = factor2.components[3];
+  return { w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2,
+           w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2,
+           w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2,
+           w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2 };
+}
+
+// q und -q beschreiben dieselbe Drehung, interpoliert wird auf dem kuerzeren Weg
+template <class FLOAT>
+Quaternion<FLOAT> nlerp(const Quaternion<FLOAT> from, Quaternion<FLOAT> to, FLOAT t) {
+  if (from.components * to.components < 0) {
+    to.components *= -1;
+  }
+  Quaternion<FLOAT> result;
+  result.components = (1 - t) * from.components + t * to.components;
+  result.normalize();
+  return result;
+}
+
+template <class FLOAT>
+Quaternion<FLOAT> slerp(const Quaternion<FLOAT> from, Quaternion<FLOAT> to, FLOAT t) {
+  FLOAT cos_theta = from.components * to.components;
+  if (cos_theta < 0) {
+    to.components *= -1;
+    cos_theta = -cos_theta;
+  }
+  // fast gleiche Drehungen: sin(theta) ist nahe 0, nlerp ist dort genau genug
+  if (cos_theta > static_cast<FLOAT>(0.9995)) {
+    return nlerp(from, to, t);
+  }
+  const FLOAT theta = std::acos(cos_theta);
+  const FLOAT sin_theta = std::sin(theta);
+  Quaternion<FLOAT> result;
+  result.components = (std::sin((1 - t) * theta) / sin_theta) * from.components
+                      + (std::sin(t * theta) / sin_theta) * to.components;
+  return result;
+}
+
+typedef Quaternion<float> Quaterniondf;
+typedef Quaternion<double> Quaterniondd;
+
+#include "quaternion_simd.h"
+
+// vorkompiliert in quaternion.cc, double nur implizit wo verwendet
+extern template struct Quaternion<float>;
+
+#endif
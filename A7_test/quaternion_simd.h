@@ -0,0 +1,39 @@
+#ifndef QUATERNION_SIMD_H
+#define QUATERNION_SIMD_H
+
+// SIMD-Spezialisierung fuer das Produkt von Quaternion<float> (nur SSE, siehe matrix_simd.h)
+// Jede Komponente von factor1 wird mit einer Permutation von factor2 (mit Vorzeichen) multipliziert,
+//   die Summen werden in derselben Reihenfolge wie in quaternion.h gebildet, die Ergebnisse sind
+//   daher bitgenau gleich. Zur Compile-Zeit wird skalar gerechnet.
+
+#include "quaternion.h"
+
+#if defined(MATH_SIMD) && !defined(__aarch64__)
+
+template <>
+constexpr Quaternion<float> operator*<float>(const Quaternion<float> factor1, const Quaternion<float> factor2) {
+  if (std::is_constant_evaluated()) {
+    const float x1 = factor1.components[0], y1 = factor1.components[1], z1 = factor1.components[2], w1 = factor1.components[3];
+    const float x2 = factor2.components[0], y2 = factor2.components[1], z2 = factor2.components[2], w2 = factor2.components[3];
+    return { w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2,
+             w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2,
+             w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2,
+             w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2 };
+  }
+  const simd::float4 b = simd::load(factor2.components);
+  // (w, -z, y, -x), (z, w, -x, -y), (-y, x, w, -z)
+  const simd::float4 b1 = simd::multiply(simd::swizzle<3, 2, 1, 0>(b), _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f));
+  const simd::float4 b2 = simd::multiply(simd::swizzle<2, 3, 0, 1>(b), _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f));
+  const simd::float4 b3 = simd::multiply(simd::swizzle<1, 0, 3, 2>(b), _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f));
+  simd::float4 r = simd::multiply(simd::broadcast(factor1.components[3]), b);
+  r = simd::add(r, simd::multiply(simd::broadcast(factor1.components[0]), b1));
+  r = simd::add(r, simd::multiply(simd::broadcast(factor1.components[1]), b2));
+  r = simd::add(r, simd::multiply(simd::broadcast(factor1.components[2]), b3));
+  Quaternion<float> result;
+  simd::store(r, result.components);
+  return result;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#include "quaternion.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+const float QUARTER = static_cast<float>(PI / 2);
+
+void expect_near(Vector3df expected, Vector3df actual, float tolerance = 1e-6f) {
+  EXPECT_NEAR(expected[0], actual[0], tolerance);
+  EXPECT_NEAR(expected[1], actual[1], tolerance);
+  EXPECT_NEAR(expected[2], actual[2], tolerance);
+}
+
+void expect_same_rotation(Quaterniondf expected, Quaterniondf actual, float tolerance = 1e-6f) {
+  // q und -q sind dieselbe Drehung
+  float sign = expected.components * actual.components < 0 ? -1.0f : 1.0f;
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_NEAR(expected.components[i], sign * actual.components[i], tolerance);
+  }
+}
+
+TEST(QUATERNION, IdentityAndAxisAngle) {
+  Quaterniondf identity;
+  expect_near({1.0f, 2.0f, 3.0f}, identity.rotate({1.0f, 2.0f, 3.0f}));
+
+  Quaterniondf rotation_z = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, QUARTER);
+  expect_near({0.0f, 1.0f, 0.0f}, rotation_z.rotate({1.0f, 0.0f, 0.0f}));
+  Quaterniondf rotation_x = Quaterniondf::from_axis_angle({1.0f, 0.0f, 0.0f}, QUARTER);
+  expect_near({0.0f, 0.0f, 1.0f}, rotation_x.rotate({0.0f, 1.0f, 0.0f}));
+  expect_near({0.0f, 1.0f, 0.0f}, rotation_x.conjugate().rotate({0.0f, 0.0f, 1.0f}));
+}
+
+// die Drehmatrix muss fuer die Drehung um z mit Affine3::from_trs uebereinstimmen
+TEST(QUATERNION, ToMatrixAndAffine) {
+  Quaterniondf rotation = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 0.7f);
+  Affine3df expected = Affine3df::from_trs({3.0f, -2.0f, 1.0f}, 0.7f, 16.0f);
+  SquareMatrix4df expected_matrix = expected.to_matrix();
+  SquareMatrix4df result = rotation.to_affine({3.0f, -2.0f, 1.0f}, 16.0f).to_matrix();
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 4; column++) {
+      EXPECT_NEAR(expected_matrix.at(row, column), result.at(row, column), 1e-5f);
+    }
+  }
+
+  Quaterniondf tilted = Quaterniondf::from_axis_angle({0.6f, 0.0f, 0.8f}, 2.1f);
+  Vector3df point = {1.0f, -2.0f, 0.5f};
+  expect_near(tilted.rotate(point), tilted.to_matrix() * point);
+}
+
+TEST(QUATERNION, ProductEqualsMatrixProduct) {
+  Quaterniondf q1 = Quaterniondf::from_axis_angle({0.6f, 0.0f, 0.8f}, 2.1f);
+  Quaterniondf q2 = Quaterniondf::from_axis_angle({0.0f, 1.0f, 0.0f}, -0.4f);
+  SquareMatrix3df expected = q1.to_matrix() * q2.to_matrix();
+  SquareMatrix3df result = (q1 * q2).to_matrix();
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t column = 0; column < 3; column++) {
+      EXPECT_NEAR(expected.at(row, column), result.at(row, column), 1e-6f);
+    }
+  }
+}
+
+// die SIMD-Spezialisierung (quaternion_simd.h) muss bitgenau mit der skalaren Rechnung uebereinstimmen
+TEST(QUATERNION, SimdProductBitExact) {
+  Quaterniondf q1 = {0.1f, -2.7f, 3.3f, 1e-3f};
+  Quaterniondf q2 = {1e7f, 3.1f, -1e-7f, 0.5f};
+  Quaterniondf product = q1 * q2;
+  const float x1 = 0.1f, y1 = -2.7f, z1 = 3.3f, w1 = 1e-3f;
+  const float x2 = 1e7f, y2 = 3.1f, z2 = -1e-7f, w2 = 0.5f;
+  EXPECT_EQ(w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2, product.components[0]);
+  EXPECT_EQ(w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2, product.components[1]);
+  EXPECT_EQ(w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2, product.components[2]);
+  EXPECT_EQ(w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2, product.components[3]);
+
+  constexpr Quaterniondf constant = Quaterniondf{0.0f, 0.0f, 1.0f, 0.0f} * Quaterniondf{1.0f, 0.0f, 0.0f, 0.0f};
+  static_assert(constant.components[1] == 1.0f);
+}
+
+TEST(QUATERNION, SlerpAndNlerp) {
+  Quaterniondf from = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 0.2f);
+  Quaterniondf to = Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 1.8f);
+
+  expect_same_rotation(from, slerp(from, to, 0.0f));
+  expect_same_rotation(to, slerp(from, to, 1.0f));
+  expect_same_rotation(Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 0.6f), slerp(from, to, 0.25f));
+  // Mitte ist bei nlerp und slerp gleich
+  expect_same_rotation(Quaterniondf::from_axis_angle({0.0f, 0.0f, 1.0f}, 1.0f), nlerp(from, to, 0.5f));
+
+  // kuerzerer Weg: -to ist dieselbe Drehung
+  Quaterniondf negated = to;
+  negated.components *= -1.0f;
+  expect_same_rotation(slerp(from, to, 0.3f), slerp(from, negated, 0.3f));
+  // fast gleiche Drehungen
+  expect_same_rotation(from, slerp(from, from, 0.5f));
+}
+
+TEST(QUATERNION, IntegrateAngularVelocity) {
+  Quaterniondf orientation;
+  Vector3df angular_velocity = {0.0f, 1.5f, 2.0f}; // 2.5 rad/s um (0, 0.6, 0.8)
+  for (int frame = 0; frame < 600; frame++) {
+    orientation.integrate(angular_velocity, 1.0f / 60.0f);
+  }
+  expect_same_rotation(Quaterniondf::from_axis_angle({0.0f, 0.6f, 0.8f}, 25.0f), orientation, 1e-4f);
+  EXPECT_NEAR(1.0f, orientation.components.length(), 1e-6f);
+
+  Quaterniondf resting = Quaterniondf::from_axis_angle({1.0f, 0.0f, 0.0f}, 0.3f);
+  Quaterniondf expected = resting;
+  resting.integrate({0.0f, 0.0f, 0.0f}, 1.0f);
+  EXPECT_EQ(expected.components[0], resting.components[0]);
+  EXPECT_EQ(expected.components[3], resting.components[3]);
+}
+
+}
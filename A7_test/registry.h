@@ -0,0 +1,99 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Interned names: a name is looked up once, when a file is loaded or at start-up, and from then on
+//   its value is reached by a Handle, an index into the values of the registry.
+// Used for the materials of the WavefrontImporter and the models of the OpenGLRenderer.
+
+// the index of a value in a Registry<T>, only valid for the registry that returned it
+template <class T>
+struct Handle {
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  uint32_t index = NONE;
+
+  bool is_valid() const { return index != NONE; }
+  bool operator==(const Handle &) const = default;
+};
+
+template <class T>
+class Registry {
+  // hashes std::string and std::string_view alike, find() needs no std::string
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+  };
+
+  std::deque<T> values; // indexed like a vector, but references stay valid when values are added
+  std::vector<std::string> names;
+  std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> indices;
+public:
+  // the handle of name, a default constructed value is added if name is new
+  Handle<T> intern(std::string_view name) {
+    const auto found = indices.find(name);
+    if (found != indices.end()) {
+      return {found->second};
+    }
+    const uint32_t index = static_cast<uint32_t>(values.size());
+    values.emplace_back();
+    names.emplace_back(name);
+    indices.emplace(names.back(), index);
+    return {index};
+  }
+
+  // the handle of name, an invalid handle if name is unknown
+  Handle<T> find(std::string_view name) const {
+    const auto found = indices.find(name);
+    return found == indices.end() ? Handle<T>{} : Handle<T>{found->second};
+  }
+
+  // handle must be valid and returned by this registry
+  T & operator[](Handle<T> handle) {
+    assert(handle.index < values.size());
+    return values[handle.index];
+  }
+  const T & operator[](Handle<T> handle) const {
+    assert(handle.index < values.size());
+    return values[handle.index];
+  }
+
+  // nullptr for an invalid handle
+  T * get(Handle<T> handle) {
+    assert(!handle.is_valid() || handle.index < values.size());
+    return handle.is_valid() ? &values[handle.index] : nullptr;
+  }
+  const T * get(Handle<T> handle) const {
+    assert(!handle.is_valid() || handle.index < values.size());
+    return handle.is_valid() ? &values[handle.index] : nullptr;
+  }
+
+  // the value of name, throws std::out_of_range if name is unknown
+  T & at(std::string_view name) {
+    const Handle<T> handle = find(name);
+    if (!handle.is_valid()) {
+      throw std::out_of_range("unknown name " + std::string(name));
+    }
+    return values[handle.index];
+  }
+
+  const std::string & name(Handle<T> handle) const {
+    assert(handle.index < names.size());
+    return names[handle.index];
+  }
+
+  // the handles are 0, 1, ..., size() - 1 in the order the names were interned
+  size_t size() const { return values.size(); }
+  bool empty() const { return values.empty(); }
+};
+
+#endif
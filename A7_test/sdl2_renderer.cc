@@ -1,68 +1,66 @@
 #include "sdl2_renderer.h"
+#include "transform.h"
+#include <cassert>
 #include <span>
 #include <utility>
 
+// Verschiebung um position, Drehung um angle und gleichmäßige Skalierung als 3x3-Matrix der Ebene
+static SquareMatrix3df transformation_2d(Vector2df position, float angle, float scale) {
+  float cos_angle, sin_angle;
+  FastMath::sincos(angle, sin_angle, cos_angle);
+  cos_angle *= scale;
+  sin_angle *= scale;
+  return { { cos_angle,   sin_angle,   0.0f},
+           {-sin_angle,   cos_angle,   0.0f},
+           { position[0], position[1], 1.0f} };
+}
 
-void SDL2Renderer::renderSpaceship(Vector2df position, float angle) {
-    static std::array<SDL_Point, 6> ship_points{SDL_Point{-6, 3},
-                                              SDL_Point{-6,-3},
-                                              SDL_Point{-10,-6},
-                                              SDL_Point{ 14, 0},
-                                              SDL_Point{-10, 6},
-                                              SDL_Point{-6, 3}};
-  
-  std::array<SDL_Point, ship_points.size()> points;
-
-  float cos_angle = std::cos(angle);
-  float sin_angle = std::sin(angle);
-  for (size_t i = 0; i < ship_points.size(); i++) {
-    float x = ship_points[i].x;
-    float y = ship_points[i].y;
-    points[i].x = (cos_angle * x - sin_angle * y) + position[0];
-    points[i].y = (sin_angle * x + cos_angle * y) + position[1];
+void SDL2Renderer::renderShape(const SquareMatrix3df & transformation, std::span<const Vector2df> shape) {
+  std::array<Vector2df, 16> transformed;
+  std::array<SDL_Point, transformed.size()> points;
+  assert(shape.size() <= transformed.size());
+
+  transform_points(transformation, shape, std::span{transformed}.first(shape.size()));
+  for (size_t i = 0; i < shape.size(); i++) {
+    points[i].x = transformed[i][0];
+    points[i].y = transformed[i][1];
   }
-  SDL_RenderDrawLines(renderer, points.data(), points.size());
+  SDL_RenderDrawLines(renderer, points.data(), shape.size());
+}
 
+
+void SDL2Renderer::renderSpaceship(Vector2df position, float angle) {
+    static constexpr std::array<Vector2df, 6> ship_points{Vector2df{-6, 3},
+                                                        Vector2df{-6,-3},
+                                                        Vector2df{-10,-6},
+                                                        Vector2df{ 14, 0},
+                                                        Vector2df{-10, 6},
+                                                        Vector2df{-6, 3}};
+
+  renderShape(transformation_2d(position, angle, 1.0f), ship_points);
 }
 
 void SDL2Renderer::render(Spaceship * ship) {
-  static SDL_Point flame_points[] { {-6, 3}, {-12, 0}, {-6, -3} };
-  std::array<SDL_Point, std::span{flame_points}.size()> points;
+  static constexpr std::array<Vector2df, 3> flame_points{ Vector2df{-6, 3}, Vector2df{-12, 0}, Vector2df{-6, -3} };
 
   if (! ship->is_in_hyperspace()) {
     if (ship->is_accelerating()) {
-      float cos_angle = std::cos(ship->get_angle());
-      float sin_angle = std::sin(ship->get_angle());
-      for (size_t i = 0; i < points.size(); i++) {
-        float x = flame_points[i].x;
-        float y = flame_points[i].y;
-        points[i].x = (cos_angle * x - sin_angle * y) + ship->get_position()[0];
-        points[i].y = (sin_angle * x + cos_angle * y) + ship->get_position()[1];
-      }
-       SDL_RenderDrawLines(renderer, points.data(), points.size());
+      renderShape(transformation_2d(ship->get_position(), ship->get_angle(), 1.0f), flame_points);
     }
   renderSpaceship(ship->get_position(), ship->get_angle());  
   }
 }
 
 void SDL2Renderer::render(Saucer * saucer) {
-  static SDL_Point saucer_points[] = { {-16, -6}, {16, -6}, {40, 6}, {-40, 6}, {-16, 18}, {16, 18},
-                                       {40, 6}, {16, -6}, {8, -18}, {-8, -18}, {-16, -6}, {-40, 6} };
-  
-  std::array<SDL_Point, std::span{saucer_points}.size()> points;
+  static constexpr std::array<Vector2df, 12> saucer_points = {
+    Vector2df{-16, -6}, Vector2df{16, -6}, Vector2df{40, 6}, Vector2df{-40, 6}, Vector2df{-16, 18}, Vector2df{16, 18},
+    Vector2df{40, 6}, Vector2df{16, -6}, Vector2df{8, -18}, Vector2df{-8, -18}, Vector2df{-16, -6}, Vector2df{-40, 6} };
 
-  Vector2df position = saucer->get_position();
   float scale = 0.5;
   if ( saucer->get_size() == 0 ) {
     scale = 0.25;
   }
-  for (size_t i = 0; i < points.size(); i++) {
-    float x = saucer_points[i].x;
-    float y = saucer_points[i].y;
-    points[i].x = scale * x + position[0];
-    points[i].y = scale * y + position[1];
-  }
-  SDL_RenderDrawLines(renderer, points.data(), points.size());
+  renderShape(transformation_2d(saucer->get_position(), 0.0f, scale), saucer_points);
 }
 
 
@@ -92,68 +90,46 @@ void SDL2Renderer::render(Asteroid * asteroid) {
   */
   
   // Kürbis-Formen (Halloween) - minimalistisch
-  static SDL_Point asteroids_points1[] = {
-    {-24, -4}, {-24, 4}, {-16, 12}, {0, 16}, {16, 12}, {24, 4}, {24, -4}, {16, -12}, {0, -16}, {-16, -12}, {-24, -4}
-  };   
-  static SDL_Point asteroids_points2[] = {
-    {-20, -6}, {-22, 2}, {-16, 10}, {0, 14}, {16, 10}, {22, 2}, {20, -6}, {12, -14}, {0, -16}, {-12, -14}, {-20, -6}
-  }; 
-  static SDL_Point asteroids_points3[] = {
-    {-26, 0}, {-20, 8}, {0, 16}, {20, 8}, {26, 0}, {20, -8}, {0, -16}, {-20, -8}, {-26, 0}
+  static constexpr std::array<Vector2df, 11> asteroids_points1 = {
+    Vector2df{-24, -4}, Vector2df{-24, 4}, Vector2df{-16, 12}, Vector2df{0, 16}, Vector2df{16, 12}, Vector2df{24, 4},
+    Vector2df{24, -4}, Vector2df{16, -12}, Vector2df{0, -16}, Vector2df{-16, -12}, Vector2df{-24, -4}
   };
-  static SDL_Point asteroids_points4[] = {  
-    {-22, -2}, {-24, 6}, {-12, 14}, {0, 16}, {12, 14}, {24, 6}, {22, -2}, {14, -12}, {0, -16}, {-14, -12}, {-22, -2}
+  static constexpr std::array<Vector2df, 11> asteroids_points2 = {
+    Vector2df{-20, -6}, Vector2df{-22, 2}, Vector2df{-16, 10}, Vector2df{0, 14}, Vector2df{16, 10}, Vector2df{22, 2},
+    Vector2df{20, -6}, Vector2df{12, -14}, Vector2df{0, -16}, Vector2df{-12, -14}, Vector2df{-20, -6}
   };
-  
-  static size_t sizes[] = {std::span{asteroids_points1}.size(),
-                           std::span{asteroids_points2}.size(),
-                           std::span{asteroids_points3}.size(),
-                           std::span{asteroids_points4}.size() };
-  size_t size = sizes[ asteroid->get_rock_type() ];
-  SDL_Point * asteroids_points = asteroids_points1;
-  if ( asteroid->get_rock_type() == 1 ) asteroids_points = asteroids_points2;
-  if ( asteroid->get_rock_type() == 2 ) asteroids_points = asteroids_points3;
-  if ( asteroid->get_rock_type() == 3 ) asteroids_points = asteroids_points4;
- 
-  SDL_Point points[std::span{asteroids_points4}.size()];
-  
+  static constexpr std::array<Vector2df, 9> asteroids_points3 = {
+    Vector2df{-26, 0}, Vector2df{-20, 8}, Vector2df{0, 16}, Vector2df{20, 8}, Vector2df{26, 0}, Vector2df{20, -8},
+    Vector2df{0, -16}, Vector2df{-20, -8}, Vector2df{-26, 0}
+  };
+  static constexpr std::array<Vector2df, 11> asteroids_points4 = {
+    Vector2df{-22, -2}, Vector2df{-24, 6}, Vector2df{-12, 14}, Vector2df{0, 16}, Vector2df{12, 14}, Vector2df{24, 6},
+    Vector2df{22, -2}, Vector2df{14, -12}, Vector2df{0, -16}, Vector2df{-14, -12}, Vector2df{-22, -2}
+  };
+  static constexpr std::array<std::span<const Vector2df>, 4> asteroids_points = {
+    asteroids_points1, asteroids_points2, asteroids_points3, asteroids_points4 };
+
   float scale = (asteroid->get_size() == 3 ? 1.0 : ( asteroid->get_size() == 2 ? 0.5 : 0.25 ));
-  Vector2df position = asteroid->get_position();
-  
+  SquareMatrix3df transformation = transformation_2d(asteroid->get_position(), 0.0f, scale);
+
   // Kürbis-Körper (Orange)
   SDL_SetRenderDrawColor(renderer, 0xFF, 0x8C, 0x00, 0xFF);
-  for (size_t i = 0; i < size; i++) {
-    points[i].x = scale * asteroids_points[i].x + position[0];
-    points[i].y = scale * asteroids_points[i].y + position[1];
-  }
-  SDL_RenderDrawLines(renderer, points, size);
-  
+  renderShape(transformation, asteroids_points[ asteroid->get_rock_type() ]);
+
   // Minimalistisches Gesicht - nur 2 Augen + Mund
   SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF); // Schwarz
-  
+
   // Linkes Auge (Dreieck)
-  SDL_Point left_eye[] = { {-10, -6}, {-6, -2}, {-14, -2}, {-10, -6} };
-  for (size_t i = 0; i < std::span{left_eye}.size(); i++) {
-    points[i].x = scale * left_eye[i].x + position[0];
-    points[i].y = scale * left_eye[i].y + position[1];
-  }
-  SDL_RenderDrawLines(renderer, points, std::span{left_eye}.size());
-  
+  static constexpr std::array<Vector2df, 4> left_eye = { Vector2df{-10, -6}, Vector2df{-6, -2}, Vector2df{-14, -2}, Vector2df{-10, -6} };
+  renderShape(transformation, left_eye);
+
   // Rechtes Auge (Dreieck)
-  SDL_Point right_eye[] = { {10, -6}, {14, -2}, {6, -2}, {10, -6} };
-  for (size_t i = 0; i < std::span{right_eye}.size(); i++) {
-    points[i].x = scale * right_eye[i].x + position[0];
-    points[i].y = scale * right_eye[i].y + position[1];
-  }
-  SDL_RenderDrawLines(renderer, points, std::span{right_eye}.size());
-  
+  static constexpr std::array<Vector2df, 4> right_eye = { Vector2df{10, -6}, Vector2df{14, -2}, Vector2df{6, -2}, Vector2df{10, -6} };
+  renderShape(transformation, right_eye);
+
   // Mund (Lächeln - 3 Punkte)
-  SDL_Point mouth[] = { {-8, 4}, {0, 6}, {8, 4} };
-  for (size_t i = 0; i < std::span{mouth}.size(); i++) {
-    points[i].x = scale * mouth[i].x + position[0];
-    points[i].y = scale * mouth[i].y + position[1];
-  }
-  SDL_RenderDrawLines(renderer, points, std::span{mouth}.size());
+  static constexpr std::array<Vector2df, 3> mouth = { Vector2df{-8, 4}, Vector2df{0, 6}, Vector2df{8, 4} };
+  renderShape(transformation, mouth);
   
   // Farbe zurücksetzen
   SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
@@ -6,6 +6,8 @@
 #include "physics.h"
 #include "game.h"
 #include "renderer.h"
+#include "matrix.h"
+#include <span>
 
 // SDL2Renderer is responsible for creating and opening a window for the Asteroid-Game, when init() is called.
 // Each time render() is called, it draws all visible game objects, score, ...
@@ -18,6 +20,9 @@ class SDL2Renderer : public Renderer {
   SDL_Surface * screenSurface = nullptr;
   SDL_Renderer * renderer = nullptr;
 
+  // transforms the points of shape and draws them as connected lines
+  void renderShape(const SquareMatrix3df & transformation, std::span<const Vector2df> shape);
+
   // render methods for the specific game objects, score, and free ships
   void renderSpaceship(Vector2df position, float angle);
   void render(Spaceship * ship); 
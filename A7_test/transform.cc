@@ -0,0 +1,186 @@
+#include "transform.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+// die Punkte liegen ohne Luecken hintereinander und werden als float-Array gelesen
+static_assert(sizeof(Vector3df) == 3 * sizeof(float));
+static_assert(sizeof(Vector2df) == 2 * sizeof(float));
+
+#if defined(MATH_SIMD)
+
+namespace simd {
+
+#if defined(__aarch64__)
+
+inline void load_xyz(const float * p, float4 & x, float4 & y, float4 & z) {
+  const float32x4x3_t v = vld3q_f32(p);
+  x = v.val[0];
+  y = v.val[1];
+  z = v.val[2];
+}
+inline void store_xyz(float * p, float4 x, float4 y, float4 z) {
+  const float32x4x3_t v = {{x, y, z}};
+  vst3q_f32(p, v);
+}
+inline void load_xy(const float * p, float4 & x, float4 & y) {
+  const float32x4x2_t v = vld2q_f32(p);
+  x = v.val[0];
+  y = v.val[1];
+}
+inline void store_xy(float * p, float4 x, float4 y) {
+  const float32x4x2_t v = {{x, y}};
+  vst2q_f32(p, v);
+}
+
+#else
+
+// vier Punkte (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) in die Register (x0 x1 x2 x3), (y0 ...), (z0 ...)
+inline void load_xyz(const float * p, float4 & x, float4 & y, float4 & z) {
+  const float4 a = _mm_loadu_ps(p);
+  const float4 b = _mm_loadu_ps(p + 4);
+  const float4 c = _mm_loadu_ps(p + 8);
+  x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+  y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+  z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+}
+inline void store_xyz(float * p, float4 x, float4 y, float4 z) {
+  _mm_storeu_ps(p, shuffle<0, 2, 0, 2>(shuffle<0, 0, 0, 0>(x, y), shuffle<0, 0, 1, 1>(z, x)));
+  _mm_storeu_ps(p + 4, shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(y, z), shuffle<2, 2, 2, 2>(x, y)));
+  _mm_storeu_ps(p + 8, shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(z, x), shuffle<3, 3, 3, 3>(y, z)));
+}
+inline void load_xy(const float * p, float4 & x, float4 & y) {
+  const float4 a = _mm_loadu_ps(p);
+  const float4 b = _mm_loadu_ps(p + 4);
+  x = shuffle<0, 2, 0, 2>(a, b);
+  y = shuffle<1, 3, 1, 3>(a, b);
+}
+inline void store_xy(float * p, float4 x, float4 y) {
+  _mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+  _mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+}
+
+#endif
+
+} // namespace simd
+
+#endif
+
+namespace {
+
+// Summationsreihenfolge wie in SquareMatrix::operator*: 0 + x * m0 + y * m1 + z * m2 + 1 * m3
+void transform_range(const SquareMatrix4df & matrix, const Vector3df * in, Vector3df * out, size_t count) {
+  size_t i = 0;
+#if defined(MATH_SIMD)
+  simd::float4 m[3][4];
+  for (size_t row = 0; row < 3; row++) {
+    for (size_t col = 0; col < 4; col++) {
+      m[row][col] = simd::broadcast(matrix.at(row, col));
+    }
+  }
+  for (; i + 4 <= count; i += 4) {
+    simd::float4 p[3];
+    simd::load_xyz(in[i].vector.data(), p[0], p[1], p[2]);
+    simd::float4 r[3];
+    for (size_t row = 0; row < 3; row++) {
+      r[row] = simd::add(simd::zero(), simd::multiply(p[0], m[row][0]));
+      r[row] = simd::add(r[row], simd::multiply(p[1], m[row][1]));
+      r[row] = simd::add(r[row], simd::multiply(p[2], m[row][2]));
+      r[row] = simd::add(r[row], m[row][3]);
+    }
+    simd::store_xyz(out[i].vector.data(), r[0], r[1], r[2]);
+  }
+#endif
+  for (; i < count; i++) {
+    const float x = in[i][0], y = in[i][1], z = in[i][2];
+    for (size_t row = 0; row < 3; row++) {
+      float sum = 0;
+      sum += x * matrix.at(row, 0);
+      sum += y * matrix.at(row, 1);
+      sum += z * matrix.at(row, 2);
+      out[i][row] = sum + matrix.at(row, 3);
+    }
+  }
+}
+
+void transform_range(const SquareMatrix3df & matrix, const Vector2df * in, Vector2df * out, size_t count) {
+  size_t i = 0;
+#if defined(MATH_SIMD)
+  simd::float4 m[2][3];
+  for (size_t row = 0; row < 2; row++) {
+    for (size_t col = 0; col < 3; col++) {
+      m[row][col] = simd::broadcast(matrix.at(row, col));
+    }
+  }
+  for (; i + 4 <= count; i += 4) {
+    simd::float4 p[2];
+    simd::load_xy(in[i].vector.data(), p[0], p[1]);
+    simd::float4 r[2];
+    for (size_t row = 0; row < 2; row++) {
+      r[row] = simd::add(simd::zero(), simd::multiply(p[0], m[row][0]));
+      r[row] = simd::add(r[row], simd::multiply(p[1], m[row][1]));
+      r[row] = simd::add(r[row], m[row][2]);
+    }
+    simd::store_xy(out[i].vector.data(), r[0], r[1]);
+  }
+#endif
+  for (; i < count; i++) {
+    const float x = in[i][0], y = in[i][1];
+    for (size_t row = 0; row < 2; row++) {
+      float sum = 0;
+      sum += x * matrix.at(row, 0);
+      sum += y * matrix.at(row, 1);
+      out[i][row] = sum + matrix.at(row, 2);
+    }
+  }
+}
+
+// teilt [0, count) in Bloecke mit einem Vielfachen von vier Punkten auf, der erste Block
+//   wird im aufrufenden Thread berechnet
+template <class MATRIX, class POINT>
+void transform_parallel(const MATRIX & matrix, std::span<const POINT> in, std::span<POINT> out, unsigned int threads) {
+  assert(in.size() == out.size());
+  const size_t count = in.size();
+  if (threads == 0) {
+    // hardware_concurrency() fragt das Betriebssystem, das kostet mehr als 1000 Punkte zu transformieren
+    static const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    threads = cores;
+  }
+  const size_t useful_threads = std::max<size_t>(1u, count / MIN_POINTS_PER_THREAD);
+  threads = static_cast<unsigned int>(std::min<size_t>(threads, useful_threads));
+  if (threads == 1) {
+    transform_range(matrix, in.data(), out.data(), count);
+    return;
+  }
+  const size_t chunk = (count / threads + 3) & ~size_t(3);
+  std::vector<std::thread> workers;
+  for (size_t begin = chunk; begin < count; begin += chunk) {
+    const size_t size = std::min(chunk, count - begin);
+    workers.emplace_back([&matrix, in, out, begin, size]() {
+      transform_range(matrix, in.data() + begin, out.data() + begin, size);
+    });
+  }
+  transform_range(matrix, in.data(), out.data(), chunk);
+  for (std::thread & worker : workers) {
+    worker.join();
+  }
+}
+
+}
+
+void transform_points(const SquareMatrix4df & matrix, std::span<const Vector3df> in, std::span<Vector3df> out,
+                      unsigned int threads) {
+  transform_parallel(matrix, in, out, threads);
+}
+
+// Affine3df * point addiert die Verschiebung zum Schluss, das entspricht der Reihenfolge oben
+void transform_points(const Affine3df & transformation, std::span<const Vector3df> in, std::span<Vector3df> out,
+                      unsigned int threads) {
+  transform_parallel(transformation.to_matrix(), in, out, threads);
+}
+
+void transform_points(const SquareMatrix3df & matrix, std::span<const Vector2df> in, std::span<Vector2df> out,
+                      unsigned int threads) {
+  transform_parallel(matrix, in, out, threads);
+}
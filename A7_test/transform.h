@@ -0,0 +1,31 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "math.h"
+#include "matrix.h"
+#include <span>
+
+// transformiert viele Punkte auf einmal (z.B. Formen, Vertex-Arrays)
+// Die Punkte werden als homogene Koordinaten mit w = 1 behandelt, das Ergebnis wird
+//   ohne perspektivische Division zurückgegeben.
+// Mit SIMD werden jeweils vier Punkte gleichzeitig berechnet; die Ergebnisse sind bitgenau
+//   gleich zu matrix * Vector4df{x, y, z, 1} bzw. Affine3df * point.
+// in und out müssen gleich lang sein und dürfen identisch sein (Transformation an Ort und Stelle),
+//   sich aber nicht teilweise überlappen.
+// threads > 1 verteilt große Arrays auf mehrere Threads, 0 verwendet alle Prozessorkerne;
+//   kleine Arrays werden immer im aufrufenden Thread berechnet.
+
+// ab dieser Anzahl von Punkten pro Thread lohnt sich das Starten eines Threads
+const size_t MIN_POINTS_PER_THREAD = 1u << 16;
+
+void transform_points(const SquareMatrix4df & matrix, std::span<const Vector3df> in, std::span<Vector3df> out,
+                      unsigned int threads = 1);
+
+void transform_points(const Affine3df & transformation, std::span<const Vector3df> in, std::span<Vector3df> out,
+                      unsigned int threads = 1);
+
+// 2D: matrix ist eine affine Abbildung der Ebene, die Verschiebung steht in der dritten Spalte
+void transform_points(const SquareMatrix3df & matrix, std::span<const Vector2df> in, std::span<Vector2df> out,
+                      unsigned int threads = 1);
+
+#endif
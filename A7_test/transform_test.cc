@@ -0,0 +1,105 @@
+#include "transform.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace {
+
+SquareMatrix4df create_matrix() {
+  return { {0.9f, 0.1f, -0.3f, 0.0f},
+           {-0.1f, 0.9f, 0.2f, 0.0f},
+           {0.7f, -0.2f, 0.95f, 0.0f},
+           {4.0f, -3.0f, 2.0f, 1.0f} };
+}
+
+// 4k + 3 Punkte, damit auch der skalare Rest berechnet wird
+std::vector<Vector3df> create_points3(size_t count) {
+  std::vector<Vector3df> points;
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i);
+    points.push_back({f * 0.5f - 7.0f, 3.0f - f * 1.3f, f * f * 0.01f});
+  }
+  return points;
+}
+
+TEST(TRANSFORM, MatrixPointsBitExact) {
+  SquareMatrix4df matrix = create_matrix();
+  std::vector<Vector3df> points = create_points3(39);
+  std::vector<Vector3df> result(points.size());
+  transform_points(matrix, points, result);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    Vector4df expected = matrix * Vector4df{points[i][0], points[i][1], points[i][2], 1.0f};
+    EXPECT_EQ(expected[0], result[i][0]);
+    EXPECT_EQ(expected[1], result[i][1]);
+    EXPECT_EQ(expected[2], result[i][2]);
+  }
+}
+
+TEST(TRANSFORM, AffinePointsBitExact) {
+  Affine3df transformation = Affine3df::from_trs({100.0f, -37.5f, 2.0f}, 0.7f, 16.0f) * Affine3df(create_matrix());
+  std::vector<Vector3df> points = create_points3(39);
+  std::vector<Vector3df> result(points.size());
+  transform_points(transformation, points, result);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    Vector3df expected = transformation * points[i];
+    EXPECT_EQ(expected[0], result[i][0]);
+    EXPECT_EQ(expected[1], result[i][1]);
+    EXPECT_EQ(expected[2], result[i][2]);
+  }
+}
+
+TEST(TRANSFORM, Points2dBitExact) {
+  SquareMatrix3df matrix = { {0.8f, 0.6f, 0.0f},
+                             {-0.6f, 0.8f, 0.0f},
+                             {512.0f, 384.0f, 1.0f} };
+  std::vector<Vector2df> points;
+  for (size_t i = 0; i < 23; i++) {
+    points.push_back({static_cast<float>(i) - 11.5f, 0.25f * static_cast<float>(i * i)});
+  }
+  std::vector<Vector2df> result(points.size());
+  transform_points(matrix, points, result);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    Vector3df expected = matrix * Vector3df{points[i][0], points[i][1], 1.0f};
+    EXPECT_EQ(expected[0], result[i][0]);
+    EXPECT_EQ(expected[1], result[i][1]);
+  }
+}
+
+TEST(TRANSFORM, InPlace) {
+  SquareMatrix4df matrix = create_matrix();
+  std::vector<Vector3df> points = create_points3(18);
+  std::vector<Vector3df> expected(points.size());
+  transform_points(matrix, points, expected);
+  transform_points(matrix, points, points);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(expected[i][0], points[i][0]);
+    EXPECT_EQ(expected[i][1], points[i][1]);
+    EXPECT_EQ(expected[i][2], points[i][2]);
+  }
+}
+
+TEST(TRANSFORM, ThreadsGiveSameResult) {
+  SquareMatrix4df matrix = create_matrix();
+  std::vector<Vector3df> points = create_points3(4 * MIN_POINTS_PER_THREAD + 5);
+  std::vector<Vector3df> single(points.size());
+  std::vector<Vector3df> parallel(points.size());
+  transform_points(matrix, points, single);
+  transform_points(matrix, points, parallel, 4);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    ASSERT_EQ(single[i][0], parallel[i][0]);
+    ASSERT_EQ(single[i][1], parallel[i][1]);
+    ASSERT_EQ(single[i][2], parallel[i][2]);
+  }
+}
+
+TEST(TRANSFORM, EmptySpan) {
+  std::vector<Vector3df> points;
+  transform_points(create_matrix(), points, points, 0);
+  EXPECT_TRUE(points.empty());
+}
+
+}
@@ -0,0 +1,120 @@
+#ifndef VECTOR_EXPRESSION_H
+#define VECTOR_EXPRESSION_H
+
+// Expression Templates fuer Vector (opt-in)
+// Summen, Differenzen, Vielfache und komponentenweise Produkte werden nicht sofort berechnet,
+//   sondern als Ausdrucksbaum gespeichert und erst von evaluate() in einer einzigen Schleife ausgewertet.
+// Beispiel: Vector2df v = expr::evaluate(expr::lazy(position) + seconds * expr::lazy(velocity));
+// Die Rechenoperationen je Komponente sind dieselben wie bei den normalen Operatoren,
+//   die Ergebnisse sind daher bitgenau gleich.
+// lazy() speichert nur eine Referenz: Ausdruecke duerfen nicht ueber das Ende der
+//   Anweisung hinaus aufgehoben werden.
+
+#include "math.h"
+#include <concepts>
+
+namespace expr {
+
+// ein Ausdruck liefert mit operator[] die i-te Komponente seines Ergebnisses
+template <class E>
+concept VectorExpression = requires(const E & e, size_t i) {
+  typename E::value_type;
+  { E::size } -> std::convertible_to<size_t>;
+  { e[i] } -> std::convertible_to<typename E::value_type>;
+};
+
+// Blatt des Ausdrucksbaums: Referenz auf einen vorhandenen Vector
+template <class F, size_t N>
+struct Reference {
+  using value_type = F;
+  static constexpr size_t size = N;
+  const Vector<F, N> & value;
+  constexpr F operator[](size_t i) const { return value.vector[i]; }
+};
+
+template <VectorExpression L, VectorExpression R>
+struct Sum {
+  using value_type = typename L::value_type;
+  static constexpr size_t size = L::size;
+  L left;
+  R right;
+  constexpr value_type operator[](size_t i) const { return left[i] + right[i]; }
+};
+
+template <VectorExpression L, VectorExpression R>
+struct Difference {
+  using value_type = typename L::value_type;
+  static constexpr size_t size = L::size;
+  L left;
+  R right;
+  constexpr value_type operator[](size_t i) const { return left[i] - right[i]; }
+};
+
+template <VectorExpression E>
+struct Scaled {
+  using value_type = typename E::value_type;
+  static constexpr size_t size = E::size;
+  value_type scalar;
+  E expression;
+  constexpr value_type operator[](size_t i) const { return expression[i] * scalar; }
+};
+
+// komponentenweises Produkt, z.B. Materialfarbe * Lichtfarbe
+template <VectorExpression L, VectorExpression R>
+struct Product {
+  using value_type = typename L::value_type;
+  static constexpr size_t size = L::size;
+  L left;
+  R right;
+  constexpr value_type operator[](size_t i) const { return left[i] * right[i]; }
+};
+
+template <class F, size_t N>
+constexpr Reference<F, N> lazy(const Vector<F, N> & value) {
+  return {value};
+}
+
+template <VectorExpression L, VectorExpression R>
+  requires (L::size == R::size)
+constexpr Sum<L, R> operator+(const L left, const R right) {
+  return {left, right};
+}
+
+template <VectorExpression L, VectorExpression R>
+  requires (L::size == R::size)
+constexpr Difference<L, R> operator-(const L left, const R right) {
+  return {left, right};
+}
+
+template <VectorExpression E>
+constexpr Scaled<E> operator*(const typename E::value_type scalar, const E expression) {
+  return {scalar, expression};
+}
+
+template <VectorExpression L, VectorExpression R>
+  requires (L::size == R::size)
+constexpr Product<L, R> multiply(const L left, const R right) {
+  return {left, right};
+}
+
+// wertet den Ausdruck in einer Schleife aus
+template <VectorExpression E>
+constexpr Vector<typename E::value_type, E::size> evaluate(const E & expression) {
+  Vector<typename E::value_type, E::size> result = {static_cast<typename E::value_type>(0.0)};
+  for (size_t i = 0; i < E::size; i++) {
+    result.vector[i] = expression[i];
+  }
+  return result;
+}
+
+// addiert den Ausdruck zu target (wie operator+=)
+template <VectorExpression E>
+constexpr void add_to(Vector<typename E::value_type, E::size> & target, const E & expression) {
+  for (size_t i = 0; i < E::size; i++) {
+    target.vector[i] += expression[i];
+  }
+}
+
+} // namespace expr
+
+#endif
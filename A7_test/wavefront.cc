@@ -4,9 +4,688 @@
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include <numbers>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string & path) {
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    error("could not open file " + path);
+    return;
+  }
+  buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  data = buffer.data();
+  size = buffer.size();
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    error("could not open file " + path);
+    return;
+  }
+  struct stat status;
+  if (fstat(file, &status) == 0 && status.st_size > 0) {
+    void * mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapped != MAP_FAILED) {
+      madvise(mapped, status.st_size, MADV_SEQUENTIAL);
+      data = static_cast<const char *>(mapped);
+      size = status.st_size;
+    } else {
+      error("could not map file " + path);
+    }
+  }
+  close(file);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data != nullptr) {
+    munmap(const_cast<char *>(data), size);
+  }
+#endif
+}
+
+std::string_view MappedFile::view() const {
+  return {data, size};
+}
+
+namespace {
+
+// the stream of an importer that only parses string_views
+std::istream & no_input() {
+  static std::istringstream empty;
+  return empty;
+}
+
+bool is_blank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void skip_blanks(std::string_view & text) {
+  size_t i = 0;
+  while (i < text.size() && is_blank(text[i])) {
+    i++;
+  }
+  text.remove_prefix(i);
+}
+
+bool is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// reads a number at the front of text (after blanks) and removes it from text
+// like std::istream, a leading '+' is accepted
+template <class NUMBER>
+bool read_number(std::string_view & text, NUMBER & number) {
+  skip_blanks(text);
+  const char * begin = text.data();
+  const char * end = begin + text.size();
+  if (begin != end && *begin == '+') {
+    begin++;
+  }
+  auto [position, result] = std::from_chars(begin, end, number);
+  if (result != std::errc()) {
+    return false;
+  }
+  text.remove_prefix(position - text.data());
+  return true;
+}
+
+// Clinger's fast path for the usual OBJ numbers like -1.368074: with at most 9 digits, a mantissa
+//   m <= 2^24 and at most 10 decimal places, m and 10^places are exact floats and m / 10^places
+//   is a single correctly rounded operation, i.e. the same result as std::from_chars and std::istream;
+//   all other numbers are read by std::from_chars
+bool read_float(std::string_view & text, float & number) {
+  static const float POWERS_OF_TEN[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+  skip_blanks(text);
+  const char * position = text.data();
+  const char * end = position + text.size();
+  const bool negative = position != end && *position == '-';
+  if (position != end && (*position == '-' || *position == '+')) {
+    position++;
+  }
+  uint32_t mantissa = 0;
+  int digits = 0, places = 0;
+  for (; position != end && is_digit(*position) && digits < 10; position++, digits++) {
+    mantissa = 10 * mantissa + (*position - '0');
+  }
+  if (position != end && *position == '.') {
+    position++;
+    for (; position != end && is_digit(*position) && digits < 10; position++, digits++, places++) {
+      mantissa = 10 * mantissa + (*position - '0');
+    }
+  }
+  const bool exact = digits > 0 && digits < 10 && mantissa <= (1u << 24) && places <= 10
+                     && (position == end || (!is_digit(*position) && *position != 'e' && *position != 'E'));
+  if (!exact) {
+    return read_number(text, number);
+  }
+  number = static_cast<float>(mantissa) / POWERS_OF_TEN[places];
+  if (negative) {
+    number = -number;
+  }
+  text.remove_prefix(position - text.data());
+  return true;
+}
+
+bool read_floats(std::string_view & text, std::array<float, 3> & floats) {
+  return read_float(text, floats[0]) && read_float(text, floats[1]) && read_float(text, floats[2]);
+}
+
+// indices are small, a loop is faster than std::from_chars
+bool read_index(std::string_view & text, long & index) {
+  skip_blanks(text);
+  size_t i = 0;
+  const bool negative = i < text.size() && text[i] == '-';
+  if (negative) {
+    i++;
+  }
+  const size_t first_digit = i;
+  long value = 0;
+  for (; i < text.size() && is_digit(text[i]) && i < first_digit + 18; i++) {
+    value = 10 * value + (text[i] - '0');
+  }
+  if (i == first_digit) {
+    return false;
+  }
+  index = negative ? -value : value;
+  text.remove_prefix(i);
+  return true;
+}
+
+// the next whitespace separated word of text
+std::string_view read_word(std::string_view & text) {
+  skip_blanks(text);
+  size_t length = 0;
+  while (length < text.size() && !is_blank(text[length])) {
+    length++;
+  }
+  std::string_view word = text.substr(0, length);
+  text.remove_prefix(length);
+  return word;
+}
+
+// index i > 0 counts from the start, i < 0 from the end of the count elements read so far;
+//   0 is invalid and mapped to a value that std::vector::at rejects
+size_t resolve_index(long index, size_t count) {
+  if (index > 0) {
+    return static_cast<size_t>(index - 1);
+  }
+  if (index < 0) {
+    return count + index;
+  }
+  return std::numeric_limits<size_t>::max();
+}
+
+// like resolve_index(), but throws std::out_of_range like std::vector::at if the index
+//   does not refer to one of the count elements
+size_t checked_index(long index, size_t count) {
+  const size_t i = resolve_index(index, count);
+  if (i >= count) {
+    throw std::out_of_range("face index out of range");
+  }
+  return i;
+}
+
+// the element an index refers to if only the first count elements have been read
+template <class ELEMENT>
+const ELEMENT & element(const std::vector<ELEMENT> & elements, long index, size_t count) {
+  return elements[checked_index(index, count)];
+}
+
+// calls function(line) for every line of text without the line break and leading blanks,
+//   empty lines are skipped
+template <class FUNCTION>
+void for_each_line(std::string_view text, FUNCTION function) {
+  while (!text.empty()) {
+    const char * line_end = static_cast<const char *>(std::memchr(text.data(), '\n', text.size()));
+    const size_t length = line_end == nullptr ? text.size() : static_cast<size_t>(line_end - text.data());
+    std::string_view line = text.substr(0, length);
+    text.remove_prefix(line_end == nullptr ? length : length + 1);
+
+    skip_blanks(line);
+    if (!line.empty()) {
+      function(line);
+    }
+  }
+}
+
+// line is the rest of a line after "v"
+void read_vertex_data(std::string_view line, std::vector<Vertice> & vertices, std::vector<Normal> & normals) {
+  std::array<float, 3> floats;
+  const char c = line.empty() ? ' ' : line[0];
+  switch (c) {
+  case 't': warning("texture vertices found and ignored (not supported)");
+            break;
+  case 'n': line.remove_prefix(1);
+            if (read_floats(line, floats)) {
+              normals.push_back(floats);
+            } else {
+              error("fail to read in a float");
+            }
+            break;
+  case 'p': warning("parameter space vertices found and ignored (not supported)");
+            break;
+  default:  if (read_floats(line, floats)) {
+              vertices.push_back(floats);
+            } else {
+              error("fail to read in a float");
+            }
+  }
+}
+
+// an index group v, v/vt, v//vn or v/vt/vn of a face, vn is 0 if no normal is given
+struct IndexGroup {
+  long v;
+  long vn;
+};
+
+// line is the rest of a line after "f"
+// reads the index groups of all corners up to the end of the line or a comment
+bool read_face(std::string_view line, std::vector<IndexGroup> & groups) {
+  groups.clear();
+  while (true) {
+    skip_blanks(line);
+    if (line.empty() || line[0] == '#') {
+      break;
+    }
+    IndexGroup group = {0, 0};
+    if (!read_index(line, group.v)) {
+      error("fail to read in a face index");
+      return false;
+    }
+    if (!line.empty() && line[0] == '/') {
+      line.remove_prefix(1);
+      long vt;
+      if (!line.empty() && line[0] != '/') {
+        read_index(line, vt); // texture index is ignored
+      }
+      if (!line.empty() && line[0] == '/') {
+        line.remove_prefix(1);
+        read_index(line, group.vn);
+      }
+    }
+    groups.push_back(group);
+  }
+  if (groups.size() < 3) {
+    error("face with less than three corners");
+    return false;
+  }
+  return true;
+}
+
+Vertice difference(const Vertice & a, const Vertice & b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+Vertice cross(const Vertice & a, const Vertice & b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+float dot(const Vertice & a, const Vertice & b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// the unit normal of the triangle a, b, c (counter-clockwise), (0, 0, 1) if it is degenerated
+Normal triangle_normal(const Vertice & a, const Vertice & b, const Vertice & c) {
+  Normal normal = cross(difference(b, a), difference(c, a));
+  const float length = std::sqrt(dot(normal, normal));
+  if (length == 0.0f) {
+    return {0.0f, 0.0f, 1.0f};
+  }
+  for (float & component : normal) {
+    component /= length;
+  }
+  return normal;
+}
+
+// a face with any number of corners, split into triangles
+// the buffers are reused for all faces of a thread
+struct Polygon {
+  std::vector<IndexGroup> groups;
+  std::vector<Vertice> corners;                  // the positions of groups
+  std::vector<std::array<uint32_t, 3>> triangles; // indices into groups
+  std::vector<uint32_t> remaining;
+
+  // splits the polygon into corners.size() - 2 triangles by ear clipping, the corners are projected
+  //   onto the coordinate plane in which the polygon (its normal after Newell) has the largest area
+  // a convex polygon becomes a fan around the first corner; if no ear is left (polygon not simple),
+  //   the rest becomes a fan as well
+  void triangulate() {
+    const size_t n = corners.size();
+    triangles.clear();
+    if (n == 3) {
+      triangles.push_back({0u, 1u, 2u});
+      return;
+    }
+    Vertice normal = {0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < n; i++) {
+      const Vertice & a = corners[i];
+      const Vertice & b = corners[(i + 1) % n];
+      normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+      normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+      normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+    }
+    size_t axis = 0;
+    for (size_t i = 1; i < 3; i++) {
+      if (std::abs(normal[i]) > std::abs(normal[axis])) {
+        axis = i;
+      }
+    }
+    const size_t x = (axis + 1) % 3, y = (axis + 2) % 3;
+    const float orientation = normal[axis] < 0.0f ? -1.0f : 1.0f;
+    // twice the projected area of the triangle, positive if it turns like the polygon
+    auto area = [this, x, y, orientation](uint32_t a, uint32_t b, uint32_t c) {
+      const Vertice & p = corners[a], & q = corners[b], & r = corners[c];
+      return orientation * ((q[x] - p[x]) * (r[y] - p[y]) - (q[y] - p[y]) * (r[x] - p[x]));
+    };
+
+    remaining.resize(n);
+    for (uint32_t i = 0; i < n; i++) {
+      remaining[i] = i;
+    }
+    size_t tip = 1, tried = 0;
+    while (remaining.size() > 3) {
+      const size_t m = remaining.size();
+      tip %= m;
+      const uint32_t a = remaining[(tip + m - 1) % m], b = remaining[tip], c = remaining[(tip + 1) % m];
+      bool ear = area(a, b, c) > 0.0f;
+      for (size_t i = 0; ear && i < m; i++) {
+        const uint32_t p = remaining[i];
+        if (p != a && p != b && p != c && area(a, b, p) >= 0.0f && area(b, c, p) >= 0.0f && area(c, a, p) >= 0.0f) {
+          ear = false;
+        }
+      }
+      if (ear) {
+        triangles.push_back({a, b, c});
+        remaining.erase(remaining.begin() + tip);
+        tried = 0;
+      } else if (++tried == m) {
+        break;
+      } else {
+        tip++;
+      }
+    }
+    for (size_t i = 1; i + 1 < remaining.size(); i++) {
+      triangles.push_back({remaining[0], remaining[i], remaining[i + 1]});
+    }
+  }
+};
+
+// calls output(BatchTriangle) for the triangles of polygon.groups, vertex_count vertices and
+//   normal_count normals have been read before
+template <class OUTPUT>
+void create_triangles(Polygon & polygon, const std::vector<Vertice> & vertices, size_t vertex_count,
+                  const std::vector<Normal> & normals, size_t normal_count, Material * material,
+                  OUTPUT output) {
+  const std::vector<IndexGroup> & groups = polygon.groups;
+  polygon.corners.clear();
+  for (const IndexGroup & group : groups) {
+    polygon.corners.push_back(element(vertices, group.v, vertex_count));
+  }
+  polygon.triangulate();
+  const bool has_normals = groups[0].vn != 0;
+  if (!has_normals) {
+    warning("no normals given");
+  }
+  if (material == nullptr) {
+    warning("no material set for face");
+  }
+  for (const std::array<uint32_t, 3> & corners : polygon.triangles) {
+    BatchTriangle triangle;
+    // smooth normals only for parse_indexed(), here the triangle is flat
+    const Normal face_normal = has_normals ? Normal{} : triangle_normal(polygon.corners[corners[0]], polygon.corners[corners[1]],
+                                                                        polygon.corners[corners[2]]);
+    for (size_t i = 0; i < 3; i++) {
+      const Normal normal = has_normals ? element(normals, groups[corners[i]].vn, normal_count) : face_normal;
+      triangle.corners[i] = { polygon.corners[corners[i]], normal };
+    }
+    triangle.material = material;
+    output(triangle);
+  }
+}
+
+Face to_face(const BatchTriangle & triangle) {
+  Face face;
+  face.reference_groups.assign(triangle.corners.begin(), triangle.corners.end());
+  face.material = triangle.material;
+  return face;
+}
+
+}
+
+// creates the vertices of an IndexedMesh for (vertex, normal) index pairs, each pair only once
+// kept by the importer together with its mesh, so repeated parse_indexed() calls add to both
+class MeshVertices {
+  static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+  IndexedMesh & mesh;
+  std::vector<uint32_t> first;  // for each vertex of the file the first mesh vertex with its position
+  std::vector<uint32_t> next;   // for each mesh vertex the next one with the same position
+  std::vector<uint32_t> normal; // for each mesh vertex the index of its normal in the file, NONE for a calculated normal
+  std::vector<size_t> positions; // of the current face, resolved
+
+  // a triangle without normals, its indices are set by calculate_normals()
+  struct Unshaded {
+    size_t v[3];  // resolved vertex indices
+    size_t index; // of its first corner in mesh.indices
+  };
+  std::vector<Unshaded> unshaded;
+
+  // the mesh vertex for the resolved vertex index and normal index n,
+  //   for n == NONE the mesh vertex with the vertex and the calculated normal value
+  uint32_t find_or_add(const std::vector<Vertice> & vertices, size_t v, uint32_t n, const Normal & value) {
+    if (first.size() <= v) {
+      first.resize(vertices.size(), NONE);
+    }
+    uint32_t * link = &first[v];
+    for (; *link != NONE; link = &next[*link]) {
+      if (normal[*link] == n && (n != NONE || mesh.normals[*link] == value)) {
+        return *link;
+      }
+    }
+    if (mesh.positions.size() == NONE) {
+      throw std::length_error("too many vertices for 32 bit indices");
+    }
+    const uint32_t added = static_cast<uint32_t>(mesh.positions.size());
+    *link = added;
+    next.push_back(NONE);
+    normal.push_back(n);
+    mesh.positions.push_back(vertices[v]);
+    mesh.normals.push_back(value);
+    return added;
+  }
+public:
+  explicit MeshVertices(IndexedMesh & mesh) : mesh(mesh) { }
+
+  // adds the triangles of polygon.groups, vertex_count vertices and normal_count normals have been read before
+  void add_face(Polygon & polygon, const std::vector<Vertice> & vertices, size_t vertex_count,
+                const std::vector<Normal> & normals, size_t normal_count) {
+    const std::vector<IndexGroup> & groups = polygon.groups;
+    positions.clear();
+    polygon.corners.clear();
+    for (const IndexGroup & group : groups) {
+      positions.push_back(checked_index(group.v, vertex_count));
+      polygon.corners.push_back(vertices[positions.back()]);
+    }
+    polygon.triangulate();
+    if (groups[0].vn == 0) {
+      for (const std::array<uint32_t, 3> & triangle : polygon.triangles) {
+        unshaded.push_back({{positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]}, mesh.indices.size()});
+        mesh.indices.insert(mesh.indices.end(), 3, NONE);
+      }
+      return;
+    }
+    for (const std::array<uint32_t, 3> & triangle : polygon.triangles) {
+      for (uint32_t corner : triangle) {
+        const uint32_t n = static_cast<uint32_t>(checked_index(groups[corner].vn, normal_count));
+        mesh.indices.push_back(find_or_add(vertices, positions[corner], n, normals[n]));
+      }
+    }
+  }
+
+  // the normal of a corner of an unshaded triangle is the sum of the (area weighted) normals of the
+  //   unshaded triangles at its position, but only of those whose normal differs by at most
+  //   crease_angle from the normal of the triangle; corners with equal position and normal share a vertex
+  // with a bounded number of triangles per position, the time is linear in the number of triangles
+  void calculate_normals(const std::vector<Vertice> & vertices, float crease_angle) {
+    if (unshaded.empty()) {
+      return;
+    }
+    // the cross product has the length of twice the area
+    std::vector<Normal> face_normals(unshaded.size());
+    std::vector<float> lengths(unshaded.size());
+    for (size_t t = 0; t < unshaded.size(); t++) {
+      const Vertice & a = vertices[unshaded[t].v[0]];
+      face_normals[t] = cross(difference(vertices[unshaded[t].v[1]], a), difference(vertices[unshaded[t].v[2]], a));
+      lengths[t] = std::sqrt(dot(face_normals[t], face_normals[t]));
+    }
+
+    // the triangles at position v are around[start[v], start[v + 1])
+    std::vector<size_t> start(vertices.size() + 1, 0u);
+    for (const Unshaded & triangle : unshaded) {
+      for (size_t v : triangle.v) {
+        start[v + 1]++;
+      }
+    }
+    for (size_t v = 0; v < vertices.size(); v++) {
+      start[v + 1] += start[v];
+    }
+    std::vector<size_t> around(start.back());
+    std::vector<size_t> filled(start.begin(), start.end() - 1);
+    for (size_t t = 0; t < unshaded.size(); t++) {
+      for (size_t v : unshaded[t].v) {
+        around[filled[v]++] = t;
+      }
+    }
+
+    const float cos_crease = std::cos(crease_angle);
+    for (size_t t = 0; t < unshaded.size(); t++) {
+      for (size_t corner = 0; corner < 3; corner++) {
+        const size_t v = unshaded[t].v[corner];
+        Normal sum = {0.0f, 0.0f, 0.0f};
+        for (size_t i = start[v]; i < start[v + 1]; i++) {
+          const size_t other = around[i];
+          if (dot(face_normals[t], face_normals[other]) >= cos_crease * lengths[t] * lengths[other]) {
+            for (size_t axis = 0; axis < 3; axis++) {
+              sum[axis] += face_normals[other][axis];
+            }
+          }
+        }
+        const float length = std::sqrt(dot(sum, sum));
+        if (length > 0.0f) {
+          for (float & component : sum) {
+            component /= length;
+          }
+        } else {
+          sum = {0.0f, 0.0f, 1.0f}; // degenerated triangles only
+        }
+        mesh.indices[unshaded[t].index + corner] = find_or_add(vertices, v, NONE, sum);
+      }
+    }
+    unshaded.clear();
+  }
+};
+
+namespace {
+
+// a face of a chunk, the indices are resolved after all chunks are parsed
+struct ChunkFace {
+  size_t first_group;  // the index groups of the face are Chunk::groups[first_group, first_group + group_count)
+  size_t group_count;
+  size_t vertex_count; // vertices and normals of the chunk before the face,
+  size_t normal_count; //   for negative indices
+};
+
+// a usemtl or mtllib line of a chunk, applied in order after all chunks are parsed
+struct MaterialLine {
+  std::string_view line;
+  size_t face;                  // faces of the chunk before the line
+  MaterialHandle material = {}; // current material after the line
+};
+
+}
+
+// a part of the text for parse(text, threads), ends after a line break
+struct Chunk {
+  std::string_view text;
+  size_t lines = 0;
+  std::vector<Vertice> vertices;
+  std::vector<Normal> normals;
+  std::vector<ChunkFace> faces;
+  std::vector<IndexGroup> groups;
+  size_t triangle_count = 0;
+  std::vector<MaterialLine> material_lines;
+
+  // set while merging
+  size_t vertex_offset = 0, normal_offset = 0, face_offset = 0;
+  MaterialHandle material = {}; // current material at the start of the chunk
+};
+
+namespace {
+
+void parse_chunk(Chunk & chunk) {
+  std::vector<IndexGroup> groups;
+  for_each_line(chunk.text, [&chunk, &groups](std::string_view line) {
+    switch (line[0]) {
+    case 'v': read_vertex_data(line.substr(1), chunk.vertices, chunk.normals);
+              break;
+    case 'f': if (read_face(line.substr(1), groups)) {
+                chunk.faces.push_back({chunk.groups.size(), groups.size(), chunk.vertices.size(), chunk.normals.size()});
+                chunk.groups.insert(chunk.groups.end(), groups.begin(), groups.end());
+                chunk.triangle_count += groups.size() - 2;
+              }
+              break;
+    case 'u':
+    case 'm': chunk.material_lines.push_back({line, chunk.faces.size()});
+              break;
+    }
+    chunk.lines++;
+  });
+}
+
+// splits text after line breaks into at most count parts of about the same size
+std::vector<Chunk> split_into_chunks(std::string_view text, size_t count) {
+  std::vector<Chunk> chunks;
+  const size_t size = text.size() / count + 1;
+  while (!text.empty()) {
+    size_t length = std::min(size, text.size());
+    const void * line_end = std::memchr(text.data() + length - 1, '\n', text.size() - length + 1);
+    length = line_end == nullptr ? text.size() : static_cast<const char *>(line_end) - text.data() + 1;
+    chunks.emplace_back();
+    chunks.back().text = text.substr(0, length);
+    text.remove_prefix(length);
+  }
+  return chunks;
+}
+
+// calls function(i) for i in [0, count) in count threads, i = 0 in the calling thread;
+//   the first exception is rethrown after all threads are finished
+template <class FUNCTION>
+void run_parallel(size_t count, FUNCTION function) {
+  if (count == 0) {
+    return;
+  }
+  std::vector<std::exception_ptr> exceptions(count);
+  auto run = [&function, &exceptions](size_t i) {
+    try {
+      function(i);
+    } catch (...) {
+      exceptions[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < count; i++) {
+    workers.emplace_back(run, i);
+  }
+  run(0);
+  for (std::thread & worker : workers) {
+    worker.join();
+  }
+  for (std::exception_ptr & exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+// below this size per thread, starting the threads costs more than it saves
+// an estimate: it has not been measured on more than one core, see BM_ParseThreads in wavefront_benchmark.cc
+const size_t MIN_BYTES_PER_THREAD = 1u << 20;
+
+// the number of threads for text, threads = 0: all processor cores, but at least MIN_BYTES_PER_THREAD per thread
+unsigned int thread_count(std::string_view text, unsigned int threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, std::max<size_t>(1u, text.size() / MIN_BYTES_PER_THREAD)));
+  }
+  return threads;
+}
+
+}
 
 WavefrontImporter::WavefrontImporter(std::istream & in) 
-  : counter_clock_wise(true), input_line(0u), in(in), current_material(nullptr) { }
+  : counter_clock_wise(true), input_line(0u), in(in), current_material(),
+    crease_angle(std::numbers::pi_v<float> / 3.0f) { }
+
+WavefrontImporter::WavefrontImporter()
+  : WavefrontImporter(no_input()) { }
+
+WavefrontImporter::~WavefrontImporter() = default;
 
 
 std::vector< Vertice > & WavefrontImporter::get_vertices() {
@@ -20,12 +699,29 @@ std::vector< Face > & WavefrontImporter::get_faces() {
   return faces;
 }
 
-std::map<std::string, Material> & WavefrontImporter::get_materials() {
+IndexedMesh & WavefrontImporter::get_mesh() {
+  return mesh;
+}
+
+Registry<Material> & WavefrontImporter::get_materials() {
   return materials;
 }
 
+const std::vector<std::string> & WavefrontImporter::get_material_libraries() const {
+  return material_libraries;
+}
+
+void WavefrontImporter::set_crease_angle(float radians) {
+  crease_angle = radians;
+}
+
 void WavefrontImporter::set_materials( std::map<std::string, Material> materials) {
-  this->materials = materials;
+  // the handle of the last usemtl belongs to the replaced registry
+  current_material = MaterialHandle{};
+  this->materials = Registry<Material>();
+  for (const auto & [name, material] : materials) {
+    this->materials[this->materials.intern(name)] = material;
+  }
 }
 
 
@@ -75,51 +771,20 @@ void WavefrontImporter::parse_vertex_data() {
 
 // no texture coordinates supported
 void WavefrontImporter::parse_face() {
-  // f v1//v1n v2//v2n v3//v3n 
-  // f v1 v2 v3
-  // f v1/vt/vn1 v2/vt/vn2 v3/vt/vn3
-  Face face;
-  size_t v1, v2, v3,
-         vn1 = 0, vn2 = 0, vn3 = 0;
-
-  auto parse_index_group = [&](size_t& v, size_t& vn) {
-    in >> v;
-    if (in.peek() == '/') {
-      in.ignore(); // skip first '/'
-      if (in.peek() != '/') {
-        // texture index present which we ignore
-        size_t vt;
-        in >> vt; 
-      }
-      if (in.peek() == '/') {
-        in.ignore(); // skip second '/'
-        in >> vn;
-      }
-    }
-  };
-
-  parse_index_group(v1, vn1);
-  parse_index_group(v2, vn2);
-  parse_index_group(v3, vn3);
- 
-  if (vn1 == 0) {
-    warning("no normals given");
-    // calculate normal not done
-    Normal normal = {1.0f, 1.0f, 1.0f};
-    face.reference_groups.push_back( { vertices.at(v1 - 1), normal } );
-    face.reference_groups.push_back( { vertices.at(v2 - 1), normal } );
-    face.reference_groups.push_back( { vertices.at(v3 - 1), normal } );
-  } else {
-    face.reference_groups.push_back( { vertices.at(v1 - 1), normals.at(vn1 - 1) } );
-    face.reference_groups.push_back( { vertices.at(v2 - 1), normals.at(vn2 - 1) } );
-    face.reference_groups.push_back( { vertices.at(v3 - 1), normals.at(vn3 - 1) } );
+  // f v1//v1n v2//v2n v3//v3n ...
+  // f v1 v2 v3 ...
+  // f v1/vt/vn1 v2/vt/vn2 v3/vt/vn3 ...
+  // the rest of the line, the line break is left for parse()
+  std::string line;
+  while (in.peek() != '\n' && in.peek() != std::char_traits<char>::eof()) {
+    line.push_back(static_cast<char>(in.get()));
   }
-  if (current_material != nullptr) {
-    face.material = current_material;
-  } else {
-    warning("no material set for face");
+  // the same reader as parse(std::string_view), so all corners are kept
+  Polygon polygon;
+  if (read_face(line, polygon.groups)) {
+    create_triangles(polygon, vertices, vertices.size(), normals, normals.size(), materials.get(current_material),
+                     [this](const BatchTriangle & triangle) { faces.push_back(to_face(triangle)); });
   }
-  faces.push_back( face );
 }
 
 void WavefrontImporter::parse_use_material() {
@@ -130,8 +795,8 @@ void WavefrontImporter::parse_use_material() {
 //    std::erase_if(s, [](char c) { return isspace(c); }); // C++ 21
 	s.erase(std::remove_if(s.begin(), s.end(), [](char c){ return isspace(static_cast<unsigned char>(c)); }), s.end());
 
-    if (materials.find(s) != materials.end() ) {
-      Material * new_material = &materials.at(s);
+    const MaterialHandle new_material = materials.find(s);
+    if (new_material.is_valid()) {
       current_material = new_material;
     }
   } else {
@@ -144,6 +809,7 @@ void WavefrontImporter::parse_material_library() {
   in >> s;
   if (s == "tllib") {
     in >> s;
+    material_libraries.push_back(s);
     std::fstream fs(s);  
     parse_material(fs); 
   } else {
@@ -173,6 +839,241 @@ void WavefrontImporter::parse() {
 
 }
 
+std::vector<Chunk> WavefrontImporter::parse_chunks(std::string_view text, unsigned int threads) {
+  std::vector<Chunk> chunks = split_into_chunks(text, threads);
+  run_parallel(chunks.size(), [&chunks](size_t i) { parse_chunk(chunks[i]); });
+
+  // in the order of the text: offsets of the chunks, vertices, normals, and material lines
+  for (Chunk & chunk : chunks) {
+    chunk.vertex_offset = vertices.size();
+    chunk.normal_offset = normals.size();
+    vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+    chunk.material = current_material;
+    for (MaterialLine & material_line : chunk.material_lines) {
+      if (material_line.line[0] == 'u') {
+        parse_use_material(material_line.line);
+      } else {
+        parse_material_library(material_line.line);
+      }
+      material_line.material = current_material;
+    }
+    input_line += chunk.lines;
+  }
+  return chunks;
+}
+
+void WavefrontImporter::parse(std::string_view text, unsigned int threads) {
+  threads = thread_count(text, threads);
+  if (threads == 1) {
+    parse_lines(text);
+    return;
+  }
+
+  std::vector<Chunk> chunks = parse_chunks(text, threads);
+  const size_t first_face = faces.size();
+  size_t face_count = first_face;
+  for (Chunk & chunk : chunks) {
+    chunk.face_offset = face_count;
+    face_count += chunk.triangle_count;
+  }
+
+  // the faces of each chunk in its own thread
+  faces.resize(face_count);
+  try {
+    run_parallel(chunks.size(), [this, &chunks](size_t i) {
+      const Chunk & chunk = chunks[i];
+      Material * material = materials.get(chunk.material);
+      auto material_line = chunk.material_lines.begin();
+      Polygon polygon;
+      size_t next = chunk.face_offset;
+      for (size_t k = 0; k < chunk.faces.size(); k++) {
+        for (; material_line != chunk.material_lines.end() && material_line->face <= k; ++material_line) {
+          material = materials.get(material_line->material);
+        }
+        const ChunkFace & face = chunk.faces[k];
+        auto groups = chunk.groups.begin() + face.first_group;
+        polygon.groups.assign(groups, groups + face.group_count);
+        create_triangles(polygon, vertices, chunk.vertex_offset + face.vertex_count,
+                         normals, chunk.normal_offset + face.normal_count, material,
+                         [this, &next](const BatchTriangle & triangle) { faces[next++] = to_face(triangle); });
+      }
+    });
+  } catch (...) {
+    faces.resize(first_face);
+    throw;
+  }
+}
+
+// same dispatch as parse()
+void WavefrontImporter::parse_lines(std::string_view text) {
+  Polygon polygon;
+  for_each_line(text, [this, &polygon](std::string_view line) {
+    switch (line[0]) {
+    case 'v': parse_vertex_data(line.substr(1));
+              break;
+    case 'f': if (read_face(line.substr(1), polygon.groups)) {
+                create_triangles(polygon, vertices, vertices.size(), normals, normals.size(), materials.get(current_material),
+                                 [this](const BatchTriangle & triangle) { faces.push_back(to_face(triangle)); });
+              }
+              break;
+    case 'u': parse_use_material(line);
+              break;
+    case 'm': parse_material_library(line);
+              break;
+    }
+    input_line++;
+  });
+}
+
+void WavefrontImporter::parse_file(const std::string & path, unsigned int threads) {
+  MappedFile file(path);
+  parse(file.view(), threads);
+}
+
+void WavefrontImporter::parse_indexed(std::string_view text, unsigned int threads) {
+  if (mesh_vertices == nullptr) {
+    mesh_vertices = std::make_unique<MeshVertices>(mesh);
+  }
+  Polygon polygon;
+  auto add_face = [this, &polygon](MaterialHandle material, size_t vertex_count, size_t normal_count) {
+    const size_t first = mesh.indices.size();
+    mesh_vertices->add_face(polygon, vertices, vertex_count, normals, normal_count);
+    if (!material.is_valid()) {
+      warning("no material set for face");
+    }
+    if (mesh.material_ranges.empty() || mesh.material_ranges.back().material != material) {
+      mesh.material_ranges.push_back({material, static_cast<uint32_t>(first), 0u});
+    }
+    mesh.material_ranges.back().count += static_cast<uint32_t>(mesh.indices.size() - first);
+  };
+
+  threads = thread_count(text, threads);
+  if (threads == 1) {
+    for_each_line(text, [this, &polygon, &add_face](std::string_view line) {
+      switch (line[0]) {
+      case 'v': parse_vertex_data(line.substr(1));
+                break;
+      case 'f': if (read_face(line.substr(1), polygon.groups)) {
+                  add_face(current_material, vertices.size(), normals.size());
+                }
+                break;
+      case 'u': parse_use_material(line);
+                break;
+      case 'm': parse_material_library(line);
+                break;
+      }
+      input_line++;
+    });
+  } else {
+    // the vertex pairs are shared by the faces of all chunks, so the faces are added in the order of the text
+    for (const Chunk & chunk : parse_chunks(text, threads)) {
+      MaterialHandle material = chunk.material;
+      auto material_line = chunk.material_lines.begin();
+      for (size_t k = 0; k < chunk.faces.size(); k++) {
+        for (; material_line != chunk.material_lines.end() && material_line->face <= k; ++material_line) {
+          material = material_line->material;
+        }
+        const ChunkFace & face = chunk.faces[k];
+        auto groups = chunk.groups.begin() + face.first_group;
+        polygon.groups.assign(groups, groups + face.group_count);
+        add_face(material, chunk.vertex_offset + face.vertex_count, chunk.normal_offset + face.normal_count);
+      }
+    }
+  }
+  mesh_vertices->calculate_normals(vertices, crease_angle);
+}
+
+void WavefrontImporter::parse_file_indexed(const std::string & path, unsigned int threads) {
+  MappedFile file(path);
+  parse_indexed(file.view(), threads);
+}
+
+void WavefrontImporter::parse_batches(std::istream & in, size_t batch_size,
+                                      const std::function<void(std::span<const BatchTriangle>)> & consume) {
+  batch_size = std::max<size_t>(batch_size, 1u);
+  std::vector<BatchTriangle> batch;
+  batch.reserve(batch_size);
+  Polygon polygon;
+  auto parse_line = [this, batch_size, &consume, &batch, &polygon](std::string_view line) {
+    switch (line[0]) {
+    case 'v': parse_vertex_data(line.substr(1));
+              break;
+    case 'f': if (read_face(line.substr(1), polygon.groups)) {
+                create_triangles(polygon, vertices, vertices.size(), normals, normals.size(), materials.get(current_material),
+                                 [batch_size, &consume, &batch](const BatchTriangle & triangle) {
+                                   batch.push_back(triangle);
+                                   if (batch.size() == batch_size) {
+                                     consume(batch);
+                                     batch.clear();
+                                   }
+                                 });
+              }
+              break;
+    case 'u': parse_use_material(line);
+              break;
+    case 'm': parse_material_library(line);
+              break;
+    }
+    input_line++;
+  };
+
+  // complete lines of a block are parsed, the rest is moved to the front and completed by the next read
+  std::string block(WAVEFRONT_BLOCK_SIZE, '\0');
+  size_t kept = 0;
+  while (in) {
+    in.read(block.data() + kept, static_cast<std::streamsize>(block.size() - kept));
+    const std::string_view text(block.data(), kept + static_cast<size_t>(in.gcount()));
+    const size_t complete = in ? text.rfind('\n') + 1 : text.size(); // 0 if there is no line break
+    if (complete == 0 && text.size() == block.size()) {
+      block.resize(2 * block.size()); // a line longer than the block
+    }
+    for_each_line(text.substr(0, complete), parse_line);
+    kept = text.size() - complete;
+    std::memmove(block.data(), block.data() + complete, kept);
+  }
+  if (!batch.empty()) {
+    consume(batch);
+  }
+}
+
+void WavefrontImporter::parse_file_batches(const std::string & path, size_t batch_size,
+                                           const std::function<void(std::span<const BatchTriangle>)> & consume) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    error("could not open file " + path);
+    return;
+  }
+  parse_batches(file, batch_size, consume);
+}
+
+void WavefrontImporter::parse_vertex_data(std::string_view line) {
+  read_vertex_data(line, vertices, normals);
+}
+
+void WavefrontImporter::parse_use_material(std::string_view line) {
+  if (read_word(line) == "usemtl") {
+    // the only lookup by name, without a std::string
+    const MaterialHandle material = materials.find(read_word(line));
+    if (material.is_valid()) {
+      current_material = material;
+    }
+  } else {
+    warning("usemtl expected");
+  }
+}
+
+void WavefrontImporter::parse_material_library(std::string_view line) {
+  if (read_word(line) == "mtllib") {
+    material_libraries.emplace_back(read_word(line));
+    std::fstream fs{material_libraries.back()};
+    parse_material(fs);
+  } else {
+    warning("mtllib expected");
+  }
+}
+
 void WavefrontImporter::parse_material(std::istream & in) {
   std::string s;
   std::string material_name;
@@ -184,7 +1085,7 @@ void WavefrontImporter::parse_material(std::istream & in) {
       if (s.size() < 3) {
         Color color = {floats[0], floats[1], floats[2]};
         
-        materials[material_name] = { color };
+        materials[materials.intern(material_name)] = { color };
       } else {
         error("not enough float values for a RGB-color");
       }